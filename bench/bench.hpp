@@ -0,0 +1,174 @@
+/*
+ABOUT:
+	bench - tiny helpers shared by the benchmarks in this directory
+
+	Every benchmark is a standalone program built by `make bench`.
+	Sizes can be overridden from the command line, the defaults are kept small
+	enough to finish in a few seconds.
+*/
+
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace bench {
+
+	inline long long now_us(void) {
+		struct timeval	tv;
+
+		gettimeofday(&tv, NULL);
+		return (tv.tv_usec + (long long)tv.tv_sec * 1000000);
+	}
+
+	/* resident set size in KiB, 0 where /proc is not available */
+	inline long rss_kb(void) {
+		long	pages = 0;
+		long	resident = 0;
+		FILE*	f = std::fopen("/proc/self/statm", "r");
+
+		if (!f)
+			return 0;
+		if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2)
+			resident = 0;
+		std::fclose(f);
+		return resident * (sysconf(_SC_PAGESIZE) / 1024);
+	}
+
+	/* peak resident set size in KiB since the last reset_peak_rss(), 0 where /proc is not available */
+	inline long peak_rss_kb(void) {
+		char	line[128];
+		long	peak = 0;
+		FILE*	f = std::fopen("/proc/self/status", "r");
+
+		if (!f)
+			return 0;
+		while (std::fgets(line, sizeof(line), f))
+			if (std::sscanf(line, "VmHWM: %ld", &peak) == 1)
+				break ;
+		std::fclose(f);
+		return peak;
+	}
+
+	inline void reset_peak_rss(void) {
+		FILE*	f = std::fopen("/proc/self/clear_refs", "w");
+
+		if (!f)
+			return ;
+		std::fputs("5", f);
+		std::fclose(f);
+	}
+
+	inline size_t arg(int argc, char** argv, int i, size_t def) {
+		if (i < argc)
+			return std::strtoul(argv[i], NULL, 10);
+		return def;
+	}
+
+	inline void report(const std::string& name, size_t ops, long long us) {
+		double	mops = us ? (double)ops / (double)us : 0.0;
+
+		std::cout << std::left << std::setw(44) << name
+				  << std::right << std::setw(10) << us / 1000 << " ms"
+				  << std::setw(10) << std::fixed << std::setprecision(2) << mops << " Mops/s" << std::endl;
+	}
+
+	/* std::less on T that counts its calls */
+	template<class T>
+	struct counting_less {
+		static size_t	calls;
+		bool operator()(const T& lhs, const T& rhs) const { ++calls; return lhs < rhs; }
+	};
+
+	template<class T>
+	size_t counting_less<T>::calls = 0;
+
+	/* what every counting_allocator did since the last reset(), whatever it was rebound to;
+		a template only so that the counters can be defined in this header */
+	template<class Unused = void>
+	struct basic_alloc_stats {
+		static size_t	calls;
+		static size_t	live;
+		static size_t	peak;
+
+		static void reset() { calls = 0; live = 0; peak = 0; }
+	};
+
+	template<class Unused>
+	size_t basic_alloc_stats<Unused>::calls = 0;
+	template<class Unused>
+	size_t basic_alloc_stats<Unused>::live = 0;
+	template<class Unused>
+	size_t basic_alloc_stats<Unused>::peak = 0;
+
+	typedef basic_alloc_stats<>	alloc_stats;
+
+	/* std::allocator that counts its allocate() calls and the bytes it holds in alloc_stats */
+	template<class T>
+	struct counting_allocator : public std::allocator<T> {
+		typedef typename std::allocator<T>::pointer		pointer;
+		typedef typename std::allocator<T>::size_type	size_type;
+
+		template<class U>
+		struct rebind { typedef counting_allocator<U> other; };
+
+		counting_allocator() {}
+		template<class U>
+		counting_allocator(const counting_allocator<U>&) {}
+
+		pointer allocate(size_type n, const void* = 0) {
+			++alloc_stats::calls;
+			alloc_stats::live += n * sizeof(T);
+			if (alloc_stats::live > alloc_stats::peak)
+				alloc_stats::peak = alloc_stats::live;
+			return std::allocator<T>::allocate(n);
+		}
+
+		void deallocate(pointer p, size_type n) {
+			alloc_stats::live -= n * sizeof(T);
+			std::allocator<T>::deallocate(p, n);
+		}
+	};
+
+	/* the i-th of n keys in 0..n-1, visited in an order that jumps all over the range */
+	inline int scattered(size_t i, size_t n) {
+		return (int)((i * 2654435761u) % n);
+	}
+
+	/* a 256 bytes mapped_type that counts its constructions; the destructor reads
+		the bytes, so building one cannot be optimised away */
+	template<class Unused = void>
+	struct basic_payload {
+		static size_t	constructed;
+		static size_t	checksum;
+		char			data[256];
+
+		basic_payload()								{ ++constructed; std::memset(data, (int)constructed, sizeof(data)); }
+		basic_payload(const basic_payload& other)	{ ++constructed; std::memcpy(data, other.data, sizeof(data)); }
+		~basic_payload()							{ for (size_t i = 0; i < sizeof(data); i += 64) checksum += data[i]; }
+	};
+
+	template<class Unused>
+	size_t basic_payload<Unused>::constructed = 0;
+	template<class Unused>
+	size_t basic_payload<Unused>::checksum = 0;
+
+	typedef basic_payload<>	payload;
+
+	/* keeps the optimiser from throwing a result away */
+	template<class T>
+	inline void keep(const T& value) {
+		volatile T sink = value;
+		(void)sink;
+	}
+}
+
+#endif
@@ -0,0 +1,53 @@
+/*
+	Comparator calls and time of lower_bound/upper_bound/equal_range on ft::map.
+
+	usage: ./bench_bounds [elements] [queries]
+*/
+
+#include "bench.hpp"
+#include "map.hpp"
+
+typedef bench::counting_less<int>	counting_less;
+
+typedef ft::map<int, int, counting_less>	int_map;
+
+static void report(const std::string& name, size_t queries, long long us) {
+	bench::report(name, queries, us);
+	std::cout << "    comparator calls per query: " << std::setprecision(2) << (double)counting_less::calls / (double)queries << std::endl;
+	counting_less::calls = 0;
+}
+
+int main(int argc, char** argv) {
+	size_t		n = bench::arg(argc, argv, 1, 1000000);
+	size_t		queries = bench::arg(argc, argv, 2, 1000000);
+	int_map		m;
+	long long	sum = 0;
+	long long	start;
+
+	for (size_t i = 0; i < n; ++i)
+		m.insert(int_map::value_type(bench::scattered(i, n) * 2, (int)i));
+	counting_less::calls = 0;
+
+	start = bench::now_us();
+	for (size_t i = 0; i < queries; ++i) {
+		int_map::iterator it = m.lower_bound((int)((i * 40503u) % (2 * n)));
+		sum += (it == m.end()) ? 0 : it->second;
+	}
+	report("lower_bound", queries, bench::now_us() - start);
+
+	start = bench::now_us();
+	for (size_t i = 0; i < queries; ++i) {
+		int_map::iterator it = m.upper_bound((int)((i * 40503u) % (2 * n)));
+		sum += (it == m.end()) ? 0 : it->second;
+	}
+	report("upper_bound", queries, bench::now_us() - start);
+
+	start = bench::now_us();
+	for (size_t i = 0; i < queries; ++i) {
+		ft::pair<int_map::iterator, int_map::iterator> range = m.equal_range((int)((i * 40503u) % (2 * n)));
+		sum += (range.first == range.second) ? 0 : range.first->second;
+	}
+	report("equal_range", queries, bench::now_us() - start);
+	bench::keep(sum);
+	return 0;
+}
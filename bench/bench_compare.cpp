@@ -0,0 +1,94 @@
+/*
+	Comparison operators of the containers:
+	== and < on two equal 64 MiB ft::vector<unsigned char> (a full scan each),
+	the same on 16M ints, a std::vector baseline for both, then ft::map and
+	ft::set pairs that differ in size, which == must reject without a walk,
+	and equal-size pairs that have to be walked.
+	Vector rows are reported in GiB/s of the two buffers read.
+
+	usage: ./bench_compare [MiB] [map elements] [repeats]
+*/
+
+#include "bench.hpp"
+#include "map.hpp"
+#include "set.hpp"
+#include "vector.hpp"
+
+#include <vector>
+
+template<class Vector>
+static void run_vector(const std::string& name, const Vector& a, const Vector& b, size_t repeats) {
+	double		bytes = 2.0 * (double)a.size() * sizeof(typename Vector::value_type) * (double)repeats;
+	long		hits = 0;
+	long long	start;
+
+	start = bench::now_us();
+	for (size_t r = 0; r < repeats; ++r)
+		hits += (a == b);
+	long long	eq = bench::now_us() - start;
+
+	start = bench::now_us();
+	for (size_t r = 0; r < repeats; ++r)
+		hits += (a < b);
+	long long	lt = bench::now_us() - start;
+
+	std::cout << std::left << std::setw(44) << name + " ==" << std::right << std::setw(10) << eq / 1000 << " ms"
+			  << std::setw(10) << std::fixed << std::setprecision(2) << (eq ? bytes / (double)eq / 1073.741824 : 0.0) << " GiB/s" << std::endl;
+	std::cout << std::left << std::setw(44) << name + " <" << std::right << std::setw(10) << lt / 1000 << " ms"
+			  << std::setw(10) << std::fixed << std::setprecision(2) << (lt ? bytes / (double)lt / 1073.741824 : 0.0) << " GiB/s" << std::endl;
+	bench::keep(hits);
+}
+
+template<class Tree>
+static void run_tree(const std::string& name, const Tree& a, const Tree& b, size_t repeats, size_t ops) {
+	long		hits = 0;
+	long long	start = bench::now_us();
+	for (size_t r = 0; r < repeats; ++r)
+		hits += (a == b);
+	bench::report(name, ops, bench::now_us() - start);
+	bench::keep(hits);
+}
+
+int main(int argc, char** argv) {
+	size_t	mib = bench::arg(argc, argv, 1, 64);
+	size_t	n = bench::arg(argc, argv, 2, 1000000);
+	size_t	repeats = bench::arg(argc, argv, 3, 10);
+	size_t	bytes = mib << 20;
+
+	std::cout << "vectors: " << mib << " MiB, trees: " << n << " elements, repeats: " << repeats << std::endl;
+	{
+		ft::vector<unsigned char>	a(bytes, 7);
+		ft::vector<unsigned char>	b(bytes, 7);
+		std::vector<unsigned char>	sa(bytes, 7);
+		std::vector<unsigned char>	sb(bytes, 7);
+		run_vector("ft::vector<unsigned char>", a, b, repeats);
+		run_vector("std::vector<unsigned char>", sa, sb, repeats);
+	}
+	{
+		ft::vector<int>		a(bytes / sizeof(int), 7);
+		ft::vector<int>		b(bytes / sizeof(int), 7);
+		std::vector<int>	sa(bytes / sizeof(int), 7);
+		std::vector<int>	sb(bytes / sizeof(int), 7);
+		run_vector("ft::vector<int>", a, b, repeats);
+		run_vector("std::vector<int>", sa, sb, repeats);
+	}
+	{
+		ft::map<int, int>	a;
+		ft::map<int, int>	b;
+		ft::set<int>		sa;
+		ft::set<int>		sb;
+		for (size_t i = 0; i < n; ++i) {
+			a.insert(ft::make_pair((int)i, (int)i));
+			b.insert(ft::make_pair((int)i, (int)i));
+			sa.insert((int)i);
+			sb.insert((int)i);
+		}
+		run_tree("ft::map == equal size (elements)", a, b, repeats, n * repeats);
+		run_tree("ft::set == equal size (elements)", sa, sb, repeats, n * repeats);
+		b.erase(0);
+		sb.erase(0);
+		run_tree("ft::map == size differs (calls)", a, b, repeats * 100000, repeats * 100000);
+		run_tree("ft::set == size differs (calls)", sa, sb, repeats * 100000, repeats * 100000);
+	}
+	return 0;
+}
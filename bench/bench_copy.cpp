@@ -0,0 +1,87 @@
+/*
+	Deep copy throughput of 10M-element containers: copy construction and
+	assignment onto an existing container of the same size but other values, for
+	ft::vector<int>, ft::vector<std::string>, ft::map<int, int> and ft::set<int>,
+	with std:: baselines. Also counts the allocator calls of one copy.
+
+	usage: ./bench_copy [elements]
+*/
+
+#include "bench.hpp"
+#include "map.hpp"
+#include "set.hpp"
+#include "vector.hpp"
+
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
+
+template<class Container>
+static void run(const std::string& name, const Container& src, const Container& other) {
+	long long	start = bench::now_us();
+	bench::alloc_stats::calls = 0;
+	{
+		Container	copy(src);
+		bench::report(name + " copy construct", src.size(), bench::now_us() - start);
+		std::cout << "    allocator calls: " << bench::alloc_stats::calls << std::endl;
+
+		Container	target(other);
+		start = bench::now_us();
+		target = copy;
+		bench::report(name + " assign", src.size(), bench::now_us() - start);
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t	n = bench::arg(argc, argv, 1, 10000000);
+
+	std::cout << "elements: " << n << std::endl;
+	{
+		ft::vector<int, bench::counting_allocator<int> >	v, v2;
+		std::vector<int, bench::counting_allocator<int> >	sv, sv2;
+		for (size_t i = 0; i < n; ++i) {
+			v.push_back((int)i);
+			v2.push_back((int)i + 1);
+			sv.push_back((int)i);
+			sv2.push_back((int)i + 1);
+		}
+		run("ft::vector<int>", v, v2);
+		run("std::vector<int>", sv, sv2);
+	}
+	{
+		ft::vector<std::string>		v, v2;
+		std::vector<std::string>	sv, sv2;
+		for (size_t i = 0; i < n; ++i) {
+			std::ostringstream s;
+			s << i;
+			v.push_back(s.str());
+			v2.push_back(s.str() + "+");
+			sv.push_back(s.str());
+			sv2.push_back(s.str() + "+");
+		}
+		run("ft::vector<std::string>", v, v2);
+		run("std::vector<std::string>", sv, sv2);
+	}
+	{
+		ft::map<int, int, std::less<int>, bench::counting_allocator<ft::pair<const int, int> > >		m, m2;
+		std::map<int, int, std::less<int>, bench::counting_allocator<std::pair<const int, int> > >	sm, sm2;
+		for (size_t i = 0; i < n; ++i) {
+			m.insert(ft::make_pair((int)i, (int)i));
+			m2.insert(ft::make_pair((int)i, (int)i + 1));
+			sm.insert(std::make_pair((int)i, (int)i));
+			sm2.insert(std::make_pair((int)i, (int)i + 1));
+		}
+		run("ft::map<int, int>", m, m2);
+		run("std::map<int, int>", sm, sm2);
+	}
+	{
+		ft::set<int, std::less<int>, bench::counting_allocator<int> >	s, s2;
+		for (size_t i = 0; i < n; ++i) {
+			s.insert((int)i);
+			s2.insert((int)i + 1);
+		}
+		run("ft::set<int>", s, s2);
+	}
+	return 0;
+}
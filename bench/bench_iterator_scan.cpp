@@ -0,0 +1,46 @@
+/*
+	Comparator invocations and time of a full in-order scan of ft::map<std::string, int>.
+	Walking the tree must not call the comparator at all.
+
+	usage: ./bench_iterator_scan [elements]
+*/
+
+#include "bench.hpp"
+#include "map.hpp"
+
+#include <sstream>
+
+typedef bench::counting_less<std::string>	counting_less;
+
+int main(int argc, char** argv) {
+	typedef ft::map<std::string, int, counting_less>	string_map;
+
+	size_t		n = bench::arg(argc, argv, 1, 1000000);
+	string_map	m;
+
+	for (size_t i = 0; i < n; ++i) {
+		std::ostringstream key;
+		key << "key-" << bench::scattered(i, n);
+		m.insert(string_map::value_type(key.str(), (int)i));
+	}
+	std::cout << "comparator calls to build " << m.size() << " entries: " << counting_less::calls << std::endl;
+
+	long long	sum = 0;
+	long long	start;
+
+	counting_less::calls = 0;
+	start = bench::now_us();
+	for (string_map::iterator it = m.begin(); it != m.end(); ++it)
+		sum += it->second;
+	bench::report("forward scan", m.size(), bench::now_us() - start);
+	std::cout << "    comparator calls: " << counting_less::calls << std::endl;
+
+	counting_less::calls = 0;
+	start = bench::now_us();
+	for (string_map::reverse_iterator it = m.rbegin(); it != m.rend(); ++it)
+		sum += it->second;
+	bench::report("reverse scan", m.size(), bench::now_us() - start);
+	std::cout << "    comparator calls: " << counting_less::calls << std::endl;
+	bench::keep(sum);
+	return 0;
+}
@@ -0,0 +1,60 @@
+/*
+	Lookups in an ft::map with a heavy (256 bytes) mapped_type.
+	Counts how many mapped_type objects every kind of lookup constructs,
+	a key-only lookup must not build any.
+
+	usage: ./bench_map_lookup [elements] [queries]
+*/
+
+#include "bench.hpp"
+#include "map.hpp"
+
+typedef bench::payload	payload;
+
+typedef ft::map<int, payload>	payload_map;
+
+static void report(const std::string& name, size_t queries, long long us) {
+	bench::report(name, queries, us);
+	std::cout << "    mapped_type constructions: " << payload::constructed << std::endl;
+	payload::constructed = 0;
+}
+
+int main(int argc, char** argv) {
+	size_t		n = bench::arg(argc, argv, 1, 200000);
+	size_t		queries = bench::arg(argc, argv, 2, 2000000);
+	payload_map	m;
+	size_t		hits = 0;
+	long long	start;
+
+	for (size_t i = 0; i < n; ++i)
+		m.insert(payload_map::value_type((int)(i * 2), payload()));
+	payload::constructed = 0;
+
+	start = bench::now_us();
+	for (size_t i = 0; i < queries; ++i)
+		hits += (m.find((int)((i * 40503u) % (2 * n))) != m.end());
+	report("find", queries, bench::now_us() - start);
+
+	start = bench::now_us();
+	for (size_t i = 0; i < queries; ++i)
+		hits += m.count((int)((i * 40503u) % (2 * n)));
+	report("count", queries, bench::now_us() - start);
+
+	start = bench::now_us();
+	for (size_t i = 0; i < queries; ++i)
+		hits += (m.lower_bound((int)((i * 40503u) % (2 * n))) != m.end());
+	report("lower_bound", queries, bench::now_us() - start);
+
+	start = bench::now_us();
+	for (size_t i = 0; i < queries; ++i)
+		hits += m.at((int)(((i * 40503u) % n) * 2)).data[0];
+	report("at (hits only)", queries, bench::now_us() - start);
+
+	start = bench::now_us();
+	for (size_t i = 0; i < n; i += 2)
+		hits += m.erase((int)(i * 2 + 1));
+	report("erase(key) of missing keys", n / 2, bench::now_us() - start);
+	bench::keep(hits);
+	bench::keep(payload::checksum);
+	return 0;
+}
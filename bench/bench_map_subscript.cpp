@@ -0,0 +1,58 @@
+/*
+	map::operator[] on hits and misses, and map::try_insert.
+	Counts comparator calls and mapped_type constructions per operation:
+	a hit must not build a mapped_type at all,
+	and a miss must not compare keys again after the descent.
+
+	usage: ./bench_map_subscript [elements] [queries]
+*/
+
+#include "bench.hpp"
+#include "map.hpp"
+
+typedef bench::payload				payload;
+typedef bench::counting_less<int>	counting_less;
+
+typedef ft::map<int, payload, counting_less>	payload_map;
+
+static void report(const std::string& name, size_t ops, long long us) {
+	bench::report(name, ops, us);
+	std::cout << "    comparisons / op: " << std::setprecision(2) << (double)counting_less::calls / (double)ops
+			  << ", mapped_type constructions / op: " << (double)payload::constructed / (double)ops << std::endl;
+	counting_less::calls = 0;
+	payload::constructed = 0;
+}
+
+int main(int argc, char** argv) {
+	size_t		n = bench::arg(argc, argv, 1, 200000);
+	size_t		queries = bench::arg(argc, argv, 2, 2000000);
+	payload_map	m;
+	payload		filler;
+	size_t		sum = 0;
+	long long	start;
+
+	counting_less::calls = 0;
+	payload::constructed = 0;
+	start = bench::now_us();
+	for (size_t i = 0; i < n; ++i)
+		sum += m[(int)(((i * 40503u) % n) * 2)].data[0];
+	report("operator[] misses (fill)", n, bench::now_us() - start);
+
+	start = bench::now_us();
+	for (size_t i = 0; i < queries; ++i)
+		sum += m[(int)(((i * 40503u) % n) * 2)].data[0];
+	report("operator[] hits", queries, bench::now_us() - start);
+
+	start = bench::now_us();
+	for (size_t i = 0; i < n; ++i)
+		sum += m.try_insert((int)(((i * 40503u) % n) * 2 + 1), filler).second;
+	report("try_insert misses", n, bench::now_us() - start);
+
+	start = bench::now_us();
+	for (size_t i = 0; i < queries; ++i)
+		sum += m.try_insert((int)((i * 40503u) % (2 * n)), filler).second;
+	report("try_insert hits", queries, bench::now_us() - start);
+	bench::keep(sum);
+	bench::keep(payload::checksum);
+	return 0;
+}
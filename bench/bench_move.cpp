@@ -0,0 +1,75 @@
+/*
+	What a C++11 build saves on element copies: push_back of 1M 32-character
+	strings into a vector that grows from empty, and insert of as many
+	pairs into a map, each with a std:: baseline.
+	A string wrapper counts its copies, its move cannot throw, so growth may
+	move it. Built as C++98 every insert and every growth copies, built with
+	`make bench STD=c++11` the count should be 0.
+
+	usage: ./bench_move [elements]
+*/
+
+#include "bench.hpp"
+#include "map.hpp"
+#include "vector.hpp"
+
+#include <map>
+#include <vector>
+
+struct counted_string {
+	static size_t	copies;
+	std::string		s;
+
+	explicit counted_string(size_t i = 0) : s(32, char('a' + i % 26)) {}
+	counted_string(const counted_string& other) : s(other.s) { ++copies; }
+	counted_string& operator=(const counted_string& other) { s = other.s; ++copies; return *this; }
+#if __cplusplus >= 201103L
+	counted_string(counted_string&& other) noexcept : s(std::move(other.s)) {}
+	counted_string& operator=(counted_string&& other) noexcept { s = std::move(other.s); return *this; }
+#endif
+};
+
+size_t counted_string::copies = 0;
+
+template<class Vector>
+static void run_vector(const std::string& name, size_t n) {
+	counted_string::copies = 0;
+	long long	start = bench::now_us();
+	{
+		Vector	v;
+		for (size_t i = 0; i < n; ++i)
+			v.push_back(typename Vector::value_type(i));
+		bench::report(name, n, bench::now_us() - start);
+		bench::keep(v.size());
+	}
+	std::cout << "    string copies: " << counted_string::copies << std::endl;
+}
+
+template<class Map, class Pair>
+static void run_map(const std::string& name, size_t n) {
+	counted_string::copies = 0;
+	long long	start = bench::now_us();
+	{
+		Map		m;
+		for (size_t i = 0; i < n; ++i)
+			m.insert(Pair((int)i, counted_string(i)));
+		bench::report(name, n, bench::now_us() - start);
+		bench::keep(m.size());
+	}
+	std::cout << "    string copies: " << counted_string::copies << std::endl;
+}
+
+int main(int argc, char** argv) {
+	size_t	n = bench::arg(argc, argv, 1, 1000000);
+
+	std::cout << "elements: " << n << ", built as " << (__cplusplus >= 201103L ? "C++11" : "C++98") << std::endl;
+	{
+		// the first rows would otherwise pay for the heap growing to its working size
+		std::vector<counted_string>	warm_up(n);
+	}
+	run_vector< ft::vector<counted_string> >("ft::vector push_back", n);
+	run_vector< std::vector<counted_string> >("std::vector push_back", n);
+	run_map< ft::map<int, counted_string>, ft::pair<const int, counted_string> >("ft::map insert", n);
+	run_map< std::map<int, counted_string>, std::pair<const int, counted_string> >("std::map insert", n);
+	return 0;
+}
@@ -0,0 +1,161 @@
+/*
+	Moving entries between two maps of 1M int -> 32-character string entries:
+	every other entry promoted from one generation to the next through
+	extract()/insert(node_type), which relinks the node as it is, against
+	insert(*it) + erase(it), which copies the value into a node of the
+	target's pool, and the same on std::map.
+	Then merge() of two maps of the same size, which is a single walk, of a
+	thousand entries into the full map, and a generational pipeline that keeps
+	inserting into a young map, merges it into an old one and evicts from that:
+	the two maps share their node pool, so the young one recycles the nodes
+	the old one evicts and, once warm, a round costs no allocation at all.
+	Allocator calls of the maps are counted on every row; the program fails
+	if node handles, merge or the warm pipeline call the allocator.
+
+	usage: ./bench_node_handle [elements] [rounds]
+*/
+
+#include "bench.hpp"
+#include "map.hpp"
+
+#include <map>
+
+typedef ft::map<int, std::string, std::less<int>, bench::counting_allocator<ft::pair<const int, std::string> > >		ft_map;
+typedef std::map<int, std::string, std::less<int>, bench::counting_allocator<std::pair<const int, std::string> > >	std_map;
+
+template<class Map>
+static void fill(Map& m, size_t n, int step, int offset) {
+	for (size_t i = 0; i < n; ++i)
+		m.insert(m.end(), typename Map::value_type((int)i * step + offset, std::string(32, char('a' + i % 26))));
+}
+
+static bool	g_failed = false;
+
+static void report(const std::string& name, size_t ops, long long start) {
+	bench::report(name, ops, bench::now_us() - start);
+	std::cout << "    allocator calls: " << bench::alloc_stats::calls << std::endl;
+}
+
+/* the rows that only relink nodes must not have called the allocator */
+static void expect_no_calls(size_t calls) {
+	if (calls == 0)
+		return ;
+	std::cout << "    FAILED: " << calls << " allocator calls, expected none" << std::endl;
+	g_failed = true;
+}
+
+static void promote_nodes(size_t n) {
+	ft_map	young;
+	ft_map	old;
+	fill(young, n, 1, 0);
+	bench::alloc_stats::calls = 0;
+	long long	start = bench::now_us();
+	for (ft_map::iterator it = young.begin(); it != young.end(); ) {
+		ft_map::iterator	next = it;
+		++next;
+		if (it->first % 2)
+			old.insert(old.end(), young.extract(it));
+		it = next;
+	}
+	report("ft::map extract + insert(node)", n / 2, start);
+	expect_no_calls(bench::alloc_stats::calls);
+}
+
+template<class Map>
+static void promote_copies(const std::string& name, size_t n) {
+	Map	young;
+	Map	old;
+	fill(young, n, 1, 0);
+	bench::alloc_stats::calls = 0;
+	long long	start = bench::now_us();
+	for (typename Map::iterator it = young.begin(); it != young.end(); ) {
+		if (it->first % 2) {
+			old.insert(old.end(), *it);
+			young.erase(it++);
+		} else
+			++it;
+	}
+	report(name + " insert(*it) + erase", n / 2, start);
+}
+
+template<class Map>
+static void merge_copies(Map& target, Map& source) {
+	for (typename Map::iterator it = source.begin(); it != source.end(); ) {
+		if (target.insert(*it).second)
+			source.erase(it++);
+		else
+			++it;
+	}
+}
+
+static void merge(size_t n) {
+	{
+		ft_map	a;
+		ft_map	b;
+		fill(a, n, 2, 0);
+		fill(b, n, 2, 1);
+		bench::alloc_stats::calls = 0;
+		long long	start = bench::now_us();
+		a.merge(b);
+		report("ft::map merge, same size", n, start);
+		expect_no_calls(bench::alloc_stats::calls);
+	}
+	{
+		std_map	a;
+		std_map	b;
+		fill(a, n, 2, 0);
+		fill(b, n, 2, 1);
+		bench::alloc_stats::calls = 0;
+		long long	start = bench::now_us();
+		merge_copies(a, b);
+		report("std::map insert + erase, same size", n, start);
+	}
+	{
+		ft_map	a;
+		ft_map	b;
+		fill(a, n, 2, 0);
+		fill(b, 1000, (int)n / 500, 1);
+		bench::alloc_stats::calls = 0;
+		long long	start = bench::now_us();
+		a.merge(b);
+		report("ft::map merge, 1000 into full", 1000, start);
+		expect_no_calls(bench::alloc_stats::calls);
+	}
+}
+
+/* each round inserts n / 10 fresh keys into young, promotes all of young into
+	old and evicts the n / 10 oldest keys of old */
+static void pipeline(size_t n, size_t rounds) {
+	ft_map	young;
+	ft_map	old;
+	int		next_key = 0;
+	size_t	batch = n / 10;
+	size_t	warm_calls = 0;
+	long long	start = bench::now_us();
+	bench::alloc_stats::calls = 0;
+	for (size_t r = 0; r < rounds; ++r) {
+		if (r == rounds / 2)
+			warm_calls = bench::alloc_stats::calls;
+		for (size_t i = 0; i < batch; ++i)
+			young.insert(young.end(), ft_map::value_type(next_key++, std::string(32, 'y')));
+		old.merge(young);
+		if (old.size() > n)
+			old.erase(old.begin(), old.lower_bound(next_key - (int)n));
+	}
+	bench::report("ft::map pipeline rounds (entries)", batch * rounds, bench::now_us() - start);
+	std::cout << "    allocator calls: " << bench::alloc_stats::calls << ", in the last " << rounds - rounds / 2 << " rounds: " << bench::alloc_stats::calls - warm_calls << std::endl;
+	expect_no_calls(bench::alloc_stats::calls - warm_calls);
+}
+
+int main(int argc, char** argv) {
+	size_t	n = bench::arg(argc, argv, 1, 1000000);
+	size_t	rounds = bench::arg(argc, argv, 2, 50);
+
+	std::cout << "elements: " << n << ", pipeline rounds: " << rounds << std::endl;
+	promote_nodes(n);
+	promote_copies<ft_map>("ft::map", n);
+	promote_copies<std_map>("std::map", n);
+	merge(n);
+	pipeline(n, rounds);
+	return g_failed ? 1 : 0;
+}
@@ -0,0 +1,86 @@
+/*
+	Per-node footprint and memory-bound access cost of the tree containers.
+	The lookup and scan timings are a cache-miss proxy, for the hardware counters
+	run it under `perf stat -e cache-misses ./bench/bench_node_size`.
+	Each timing is taken twice: on the nodes as they are, and on nodes that
+	carry a copy of the comparator again, the way they used to, so the two
+	sizes are compared on the same insert order and the same queries.
+
+	usage: ./bench_node_size [elements]
+*/
+
+#include "bench.hpp"
+#include "map.hpp"
+#include "set.hpp"
+
+typedef ft::map<int, int>	int_map;
+
+/* puts back the comparator copy every node used to carry, 8 bytes with padding */
+struct comparator_copy {
+	typedef ft::false_type	augmented;
+	typedef ft::false_type	counted;
+	typedef void			summary_type;
+
+	template<class Value>
+	struct node_data {
+		std::less<Value>	comp;
+
+		void update(const node_data*, const node_data*, const Value&) {}
+	};
+};
+
+typedef ft::set<int, std::less<int>, std::allocator<int>, comparator_copy>	wide_set;
+
+static int make_int(size_t i)					{ return (int)i; }
+static long make_long(size_t i)					{ return (long)i; }
+static int_map::value_type make_pair(size_t i)	{ return int_map::value_type((int)i, (int)i); }
+
+template<class Set>
+static void footprint(const std::string& name, size_t node_size, size_t n, typename Set::value_type (*make)(size_t)) {
+	long	rss_before = bench::rss_kb();
+	Set		s;
+
+	for (size_t i = 0; i < n; ++i)
+		s.insert(make(bench::scattered(i, n)));
+	std::cout << std::left << std::setw(24) << name
+			  << "sizeof(node) " << std::setw(4) << node_size
+			  << "rss per element " << std::fixed << std::setprecision(2)
+			  << (double)(bench::rss_kb() - rss_before) * 1024 / (double)n << " bytes" << std::endl;
+}
+
+/* the same inserts, random lookups and in-order scan on a set of n scattered keys */
+template<class Set>
+static void traversal(const std::string& name, size_t node_size, size_t n) {
+	Set			s;
+	std::cout << name << ", sizeof(node) " << node_size << ":" << std::endl;
+	long long	start = bench::now_us();
+	for (size_t i = 0; i < n; ++i)
+		s.insert(bench::scattered(i, n));
+	bench::report("    insert", n, bench::now_us() - start);
+
+	size_t found = 0;
+	start = bench::now_us();
+	for (size_t i = 0; i < n; ++i)
+		found += s.count((int)((i * 40503u) % n));
+	bench::report("    random count", n, bench::now_us() - start);
+	bench::keep(found);
+
+	long long sum = 0;
+	start = bench::now_us();
+	for (typename Set::iterator it = s.begin(); it != s.end(); ++it)
+		sum += *it;
+	bench::report("    full scan", n, bench::now_us() - start);
+	bench::keep(sum);
+}
+
+int main(int argc, char** argv) {
+	size_t	n = bench::arg(argc, argv, 1, 1000000);
+
+	footprint< ft::set<int> >("ft::set<int>", sizeof(ft::_Rb_tree<int>::node), n, make_int);
+	footprint< ft::set<long> >("ft::set<long>", sizeof(ft::_Rb_tree<long>::node), n, make_long);
+	footprint< int_map >("ft::map<int,int>", sizeof(ft::_Rb_tree<int, int_map::value_type, ft::_Select1st<int_map::value_type> >::node), n, make_pair);
+
+	traversal< ft::set<int> >("ft::set<int>", sizeof(ft::_Rb_tree<int>::node), n);
+	traversal< wide_set >("ft::set<int> with a comparator copy per node", sizeof(ft::_Rb_tree<int, int, ft::_Identity<int>, std::less<int>, std::allocator<int>, comparator_copy>::node), n);
+	return 0;
+}
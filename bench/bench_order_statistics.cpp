@@ -0,0 +1,84 @@
+/*
+	What ft::tree_order_statistics costs and buys on 1M int -> int entries.
+	Cost: node size, and insert and erase of every key in a scattered order,
+	against the plain ft::map and std::map, as the subtree sizes are kept up
+	to date on every path from a changed node to the root.
+	Gain: random pages fetched by index, nth(k) against advancing k steps from
+	begin(), and the index of random keys, rank(key) against
+	std::distance(begin(), lower_bound(key)). The walking rows only run a
+	thousandth of the queries, every query row also shows its time per query.
+
+	usage: ./bench_order_statistics [elements] [queries]
+*/
+
+#include "bench.hpp"
+#include "map.hpp"
+
+#include <iterator>
+#include <map>
+
+typedef ft::map<int, int>																	plain_map;
+typedef ft::map<int, int, std::less<int>, std::allocator<int>, ft::tree_order_statistics>	ranked_map;
+
+static void report_queries(const std::string& name, size_t queries, long long us) {
+	bench::report(name, queries, us);
+	std::cout << "    per query: " << std::fixed << std::setprecision(3) << (double)us / (double)queries << " us" << std::endl;
+}
+
+template<class Map>
+static void run_update(const std::string& name, size_t n) {
+	Map			m;
+	long long	start = bench::now_us();
+	for (size_t i = 0; i < n; ++i)
+		m.insert(typename Map::value_type(bench::scattered(i, n), (int)i));
+	bench::report(name + " insert", n, bench::now_us() - start);
+	start = bench::now_us();
+	for (size_t i = 0; i < n; ++i)
+		m.erase(bench::scattered(i, n));
+	bench::report(name + " erase", n, bench::now_us() - start);
+	bench::keep(m.size());
+}
+
+int main(int argc, char** argv) {
+	size_t	n = bench::arg(argc, argv, 1, 1000000);
+	size_t	queries = bench::arg(argc, argv, 2, 1000000);
+	size_t	walks = queries / 1000 + 1;
+
+	std::cout << "elements: " << n << ", queries: " << queries << ", walking queries: " << walks << std::endl;
+	std::cout << "sizeof(node) plain " << sizeof(ft::_Rb_tree<int, plain_map::value_type, ft::_Select1st<plain_map::value_type> >::node)
+			  << ", order statistics " << sizeof(ft::_Rb_tree<int, ranked_map::value_type, ft::_Select1st<ranked_map::value_type>, std::less<int>,
+												std::allocator<ranked_map::value_type>, ft::tree_order_statistics>::node) << std::endl;
+	run_update<plain_map>("ft::map", n);
+	run_update<ranked_map>("ft::map order statistics", n);
+	run_update< std::map<int, int> >("std::map", n);
+
+	ranked_map			ranked;
+	std::map<int, int>	plain;
+	for (size_t i = 0; i < n; ++i) {
+		ranked.insert(ft::make_pair((int)i, (int)i));
+		plain.insert(std::make_pair((int)i, (int)i));
+	}
+	long		sum = 0;
+	long long	start = bench::now_us();
+	for (size_t q = 0; q < queries; ++q)
+		sum += ranked.nth(bench::scattered(q, n))->second;
+	report_queries("ft::map nth(k)", queries, bench::now_us() - start);
+	start = bench::now_us();
+	for (size_t q = 0; q < walks; ++q) {
+		std::map<int, int>::iterator	it = plain.begin();
+		std::advance(it, bench::scattered(q, n));
+		sum += it->second;
+	}
+	report_queries("std::map advance(begin(), k)", walks, bench::now_us() - start);
+
+	start = bench::now_us();
+	for (size_t q = 0; q < queries; ++q)
+		sum += (long)ranked.rank(bench::scattered(q, n));
+	report_queries("ft::map rank(key)", queries, bench::now_us() - start);
+	start = bench::now_us();
+	for (size_t q = 0; q < walks; ++q)
+		sum += std::distance(plain.begin(), plain.lower_bound(bench::scattered(q, n)));
+	report_queries("std::map distance(begin(), lower_bound(key))", walks, bench::now_us() - start);
+	bench::keep(sum);
+	return 0;
+}
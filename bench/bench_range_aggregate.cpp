@@ -0,0 +1,101 @@
+/*
+	Sums of the values in key windows of a map of 1M int -> long entries:
+	aggregate(lo, hi) of a map built with ft::tree_aggregate<aggregate_sum<long> >
+	against a walk from lower_bound(lo) to lower_bound(hi) on ft::map and std::map,
+	for windows of 100, 10k and 1M keys; on wide windows the walks run fewer
+	queries, the rates compare. Then what keeping the sums costs, insert
+	and erase of every key against the plain ft::map, and updates of values
+	through update(), which brings the sums above the entry up to date.
+
+	usage: ./bench_range_aggregate [elements] [queries]
+*/
+
+#include "bench.hpp"
+#include "map.hpp"
+
+#include <map>
+#include <sstream>
+
+typedef ft::map<int, long>																							plain_map;
+typedef ft::map<int, long, std::less<int>, std::allocator<int>, ft::tree_aggregate<ft::aggregate_sum<long> > >	sum_map;
+
+template<class Map>
+static long walk(const Map& m, int lo, int hi) {
+	long	sum = 0;
+	for (typename Map::const_iterator it = m.lower_bound(lo), last = m.lower_bound(hi); it != last; ++it)
+		sum += it->second;
+	return sum;
+}
+
+template<class Map>
+static void run_walk(const std::string& name, const Map& m, size_t n, size_t queries, size_t width) {
+	long		sum = 0;
+	long long	start = bench::now_us();
+	for (size_t q = 0; q < queries; ++q) {
+		int lo = bench::scattered(q, n - width + 1);
+		sum += walk(m, lo, lo + (int)width);
+	}
+	bench::report(name, queries, bench::now_us() - start);
+	bench::keep(sum);
+}
+
+static void run_aggregate(const std::string& name, const sum_map& m, size_t n, size_t queries, size_t width) {
+	long		sum = 0;
+	long long	start = bench::now_us();
+	for (size_t q = 0; q < queries; ++q) {
+		int lo = bench::scattered(q, n - width + 1);
+		sum += m.aggregate(lo, lo + (int)width);
+	}
+	bench::report(name, queries, bench::now_us() - start);
+	bench::keep(sum);
+}
+
+template<class Map>
+static void run_update(const std::string& name, size_t n) {
+	Map			m;
+	long long	start = bench::now_us();
+	for (size_t i = 0; i < n; ++i)
+		m.insert(typename Map::value_type(bench::scattered(i, n), (long)i));
+	bench::report(name + " insert", n, bench::now_us() - start);
+	start = bench::now_us();
+	for (size_t i = 0; i < n; ++i)
+		m.erase(bench::scattered(i, n));
+	bench::report(name + " erase", n, bench::now_us() - start);
+	bench::keep(m.size());
+}
+
+int main(int argc, char** argv) {
+	size_t	n = bench::arg(argc, argv, 1, 1000000);
+	size_t	queries = bench::arg(argc, argv, 2, 100000);
+
+	std::cout << "elements: " << n << ", queries: " << queries << std::endl;
+	{
+		plain_map			plain;
+		sum_map				sums;
+		std::map<int, long>	std_map;
+		for (size_t i = 0; i < n; ++i) {
+			plain.insert(ft::make_pair((int)i, (long)i));
+			sums.insert(ft::make_pair((int)i, (long)i));
+			std_map.insert(std::make_pair((int)i, (long)i));
+		}
+		size_t	widths[] = { 100, 10000, n };
+		for (size_t w = 0; w < 3; ++w) {
+			size_t	width = std::min(widths[w], n);
+			size_t	walks = std::max<size_t>(queries * 100 / width, 1);
+			std::ostringstream	label;
+			label << ", window " << width;
+			run_aggregate("ft::map aggregate" + label.str(), sums, n, queries, width);
+			run_walk("ft::map walk" + label.str(), plain, n, std::min(walks, queries), width);
+			run_walk("std::map walk" + label.str(), std_map, n, std::min(walks, queries), width);
+		}
+		long long	start = bench::now_us();
+		for (size_t q = 0; q < queries; ++q) {
+			sum_map::iterator	it = sums.find(bench::scattered(q, n));
+			sums.update(it, it->second + 1);
+		}
+		bench::report("ft::map aggregate value update", queries, bench::now_us() - start);
+	}
+	run_update<plain_map>("ft::map", n);
+	run_update<sum_map>("ft::map aggregate", n);
+	return 0;
+}
@@ -0,0 +1,64 @@
+/*
+	Heap allocations of a request-processing loop: every request collects its
+	header ids, path segments and a parse stack, most of them 1-8 entries long,
+	one request in 64 carries 40 headers. The same loop runs over ft::vector,
+	std::vector and ft::small_vector<T, 8>, all behind a counting allocator.
+
+	usage: ./bench_small_vector [requests]
+*/
+
+#include "bench.hpp"
+#include "small_vector.hpp"
+#include "stack.hpp"
+#include "vector.hpp"
+
+#include <vector>
+
+/* deterministic request shape, request i gets the same sizes under every container */
+static size_t headers_of(size_t i)	{ return (i % 64 == 63) ? 40 : 1 + (i * 2654435761u >> 7) % 8; }
+static size_t segments_of(size_t i)	{ return 1 + (i * 40503u >> 5) % 5; }
+
+template<class Seq>
+static long process(size_t i) {
+	Seq			headers;
+	Seq			segments;
+	ft::stack<int, Seq>	nesting;
+	long		checksum = 0;
+
+	for (size_t h = headers_of(i); h--; )
+		headers.push_back((int)(h * 31 + i));
+	for (size_t s = segments_of(i); s--; )
+		segments.push_back((int)s);
+	for (size_t k = 0; k < segments.size(); ++k) {
+		nesting.push(segments[k]);
+		if (k % 2)
+			nesting.pop();
+	}
+	for (size_t h = 0; h < headers.size(); ++h)
+		checksum += headers[h];
+	return checksum + nesting.size();
+}
+
+template<class Seq>
+static void run(const std::string& name, size_t requests) {
+	long		checksum = 0;
+
+	bench::alloc_stats::calls = 0;
+	long long	start = bench::now_us();
+	for (size_t i = 0; i < requests; ++i)
+		checksum += process<Seq>(i);
+	bench::report(name, requests, bench::now_us() - start);
+	std::cout << "    allocations: " << bench::alloc_stats::calls
+			  << " (" << std::setprecision(2) << (double)bench::alloc_stats::calls / (double)requests << " per request)" << std::endl;
+	bench::keep(checksum);
+}
+
+int main(int argc, char** argv) {
+	size_t	requests = bench::arg(argc, argv, 1, 1000000);
+
+	std::cout << "requests: " << requests << std::endl;
+	run< ft::vector<int, bench::counting_allocator<int> > >("ft::vector", requests);
+	run< std::vector<int, bench::counting_allocator<int> > >("std::vector", requests);
+	run< ft::small_vector<int, 8, bench::counting_allocator<int> > >("ft::small_vector<int, 8>", requests);
+	return 0;
+}
@@ -0,0 +1,51 @@
+/*
+	Loading a sorted snapshot into ft::map: range constructor on sorted input,
+	the ft::sorted_unique tagged constructor and one-by-one insertion,
+	with the number of comparator calls of each.
+
+	usage: ./bench_sorted_build [elements]
+*/
+
+#include "bench.hpp"
+#include "map.hpp"
+
+#include <vector>
+
+typedef bench::counting_less<int>	counting_less;
+
+typedef ft::map<int, int, counting_less>	int_map;
+
+static void report(const std::string& name, const int_map& m, size_t n, long long us) {
+	bench::report(name, n, us);
+	std::cout << "    size " << m.size() << ", comparator calls: " << counting_less::calls << std::endl;
+	counting_less::calls = 0;
+}
+
+int main(int argc, char** argv) {
+	size_t								n = bench::arg(argc, argv, 1, 5000000);
+	std::vector<int_map::value_type>	rows;
+	long long							start;
+
+	rows.reserve(n);
+	for (size_t i = 0; i < n; ++i)
+		rows.push_back(int_map::value_type((int)i, (int)i));
+
+	{
+		start = bench::now_us();
+		int_map m;
+		for (size_t i = 0; i < n; ++i)
+			m.insert(rows[i]);
+		report("insert one by one", m, n, bench::now_us() - start);
+	}
+	{
+		start = bench::now_us();
+		int_map m(rows.begin(), rows.end());
+		report("range constructor (sorted input)", m, n, bench::now_us() - start);
+	}
+	{
+		start = bench::now_us();
+		int_map m(ft::sorted_unique, rows.begin(), rows.end());
+		report("sorted_unique constructor", m, n, bench::now_us() - start);
+	}
+	return 0;
+}
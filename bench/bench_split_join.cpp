@@ -0,0 +1,66 @@
+/*
+	Cutting a map of 1M int -> int entries in two and putting it back together:
+	split_off() at a key and append() of the upper half, repeated at split
+	points spread over the whole range, against the std::map way of doing the
+	same, a range insert of [lower_bound(key), end()) into an empty map then an
+	erase of that range, and a range insert back. Rates are in entries moved.
+	Split and append cut and join along O(log n) nodes and relink the parts
+	as they are, the two maps sharing one node pool; on a plain map the split
+	still counts the smaller part to size it. The std rows copy the moved half
+	and search for every entry.
+
+	usage: ./bench_split_join [elements] [rounds]
+*/
+
+#include "bench.hpp"
+#include "map.hpp"
+
+#include <map>
+
+template<class Map>
+static void fill(Map& m, size_t n) {
+	for (size_t i = 0; i < n; ++i)
+		m.insert(typename Map::value_type((int)i, (int)i));
+}
+
+static void run_ft(const std::string& name, size_t n, size_t rounds, size_t denominator) {
+	ft::map<int, int>	m;
+	fill(m, n);
+	long long	start = bench::now_us();
+	size_t		moved = 0;
+	for (size_t r = 0; r < rounds; ++r) {
+		ft::map<int, int>	right = m.split_off((int)(n / denominator * (r % denominator)));
+		moved += right.size();
+		m.append(right);
+	}
+	bench::report(name, moved, bench::now_us() - start);
+	bench::keep(moved + m.size());
+}
+
+static void run_std(const std::string& name, size_t n, size_t rounds, size_t denominator) {
+	std::map<int, int>	m;
+	fill(m, n);
+	long long	start = bench::now_us();
+	size_t		moved = 0;
+	for (size_t r = 0; r < rounds; ++r) {
+		std::map<int, int>::iterator	cut = m.lower_bound((int)(n / denominator * (r % denominator)));
+		std::map<int, int>				right(cut, m.end());
+		m.erase(cut, m.end());
+		moved += right.size();
+		m.insert(right.begin(), right.end());
+	}
+	bench::report(name, moved, bench::now_us() - start);
+	bench::keep(moved + m.size());
+}
+
+int main(int argc, char** argv) {
+	size_t	n = bench::arg(argc, argv, 1, 1000000);
+	size_t	rounds = bench::arg(argc, argv, 2, 20);
+
+	std::cout << "elements: " << n << ", rounds: " << rounds << std::endl;
+	run_ft("ft::map split_off + append, middle", n, rounds, 2);
+	run_std("std::map copy + erase + insert, middle", n, rounds, 2);
+	run_ft("ft::map split_off + append, spread", n, rounds, 10);
+	run_std("std::map copy + erase + insert, spread", n, rounds, 10);
+	return 0;
+}
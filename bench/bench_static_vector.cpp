@@ -0,0 +1,109 @@
+/*
+	Push/pop-heavy loops over ft::static_vector<int, 64> against ft::vector<int>
+	with reserve(64), used directly and as the container of an ft::stack:
+	one long-lived container going through a bracket-matching parse, then a
+	fresh parse stack per short message, where the vector pays its reserve.
+
+	usage: ./bench_static_vector [operations] [messages]
+*/
+
+#include "bench.hpp"
+#include "stack.hpp"
+#include "static_vector.hpp"
+#include "vector.hpp"
+
+/* nesting depth of token i, it never leaves [0, 64) */
+static bool opens(size_t i, size_t depth) {
+	if (depth == 0)
+		return true;
+	if (depth == 63)
+		return false;
+	return ((i * 2654435761u) >> 13) & 1;
+}
+
+struct reserved {
+	template<class Seq>
+	static void prepare(Seq& seq) { seq.reserve(64); }
+};
+
+struct as_is {
+	template<class Seq>
+	static void prepare(Seq&) {}
+};
+
+template<class Seq, class Prepare>
+static void run_direct(const std::string& name, size_t ops) {
+	Seq		seq;
+	long	checksum = 0;
+
+	Prepare::prepare(seq);
+	long long	start = bench::now_us();
+	for (size_t i = 0; i < ops; ++i) {
+		if (opens(i, seq.size()))
+			seq.push_back((int)i);
+		else {
+			checksum += seq.back();
+			seq.pop_back();
+		}
+	}
+	bench::report(name, ops, bench::now_us() - start);
+	bench::keep(checksum);
+}
+
+/* ft::stack copies the container it is given, a vector's reserve does not survive that:
+	it grows once during the first 64 pushes */
+template<class Seq>
+static void run_stack(const std::string& name, size_t ops) {
+	ft::stack<int, Seq>	stack;
+	long				checksum = 0;
+
+	long long	start = bench::now_us();
+	for (size_t i = 0; i < ops; ++i) {
+		if (opens(i, stack.size()))
+			stack.push((int)i);
+		else {
+			checksum += stack.top();
+			stack.pop();
+		}
+	}
+	bench::report(name, ops, bench::now_us() - start);
+	bench::keep(checksum);
+}
+
+/* a new container per message of 48 tokens */
+template<class Seq, class Prepare>
+static void run_messages(const std::string& name, size_t messages) {
+	long	checksum = 0;
+
+	long long	start = bench::now_us();
+	for (size_t m = 0; m < messages; ++m) {
+		Seq		seq;
+
+		Prepare::prepare(seq);
+		for (size_t i = m; i < m + 48; ++i) {
+			if (opens(i, seq.size()))
+				seq.push_back((int)i);
+			else {
+				checksum += seq.back();
+				seq.pop_back();
+			}
+		}
+		checksum += seq.size();
+	}
+	bench::report(name, messages * 48, bench::now_us() - start);
+	bench::keep(checksum);
+}
+
+int main(int argc, char** argv) {
+	size_t	ops = bench::arg(argc, argv, 1, 100000000);
+	size_t	messages = bench::arg(argc, argv, 2, 2000000);
+
+	std::cout << "push/pop: " << ops << ", messages: " << messages << std::endl;
+	run_direct< ft::vector<int>, reserved >("ft::vector reserve(64)", ops);
+	run_direct< ft::static_vector<int, 64>, as_is >("ft::static_vector<int, 64>", ops);
+	run_stack< ft::vector<int> >("ft::stack over ft::vector", ops);
+	run_stack< ft::static_vector<int, 64> >("ft::stack over ft::static_vector", ops);
+	run_messages< ft::vector<int>, reserved >("per message ft::vector reserve(64)", messages);
+	run_messages< ft::static_vector<int, 64>, as_is >("per message ft::static_vector", messages);
+	return 0;
+}
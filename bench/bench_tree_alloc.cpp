@@ -0,0 +1,49 @@
+/*
+	Insert/erase throughput and resident memory of ft::map against std::map.
+	std::map allocates every node on its own, ft::map takes them from node_pool slabs.
+
+	usage: ./bench_tree_alloc [elements]
+*/
+
+#include "bench.hpp"
+#include "map.hpp"
+
+#include <map>
+
+template<class Map>
+static void run(const std::string& name, size_t n) {
+	long		rss_before = bench::rss_kb();
+	long long	start;
+	{
+		Map m;
+
+		start = bench::now_us();
+		for (size_t i = 0; i < n; ++i)
+			m.insert(typename Map::value_type(bench::scattered(i, n), (int)i));
+		bench::report(name + " insert", n, bench::now_us() - start);
+		std::cout << "    rss growth: " << bench::rss_kb() - rss_before << " KiB for " << m.size() << " nodes" << std::endl;
+
+		start = bench::now_us();
+		for (size_t i = 0; i < n; i += 2)
+			m.erase(bench::scattered(i, n));
+		bench::report(name + " erase half", n / 2, bench::now_us() - start);
+
+		start = bench::now_us();
+		for (size_t i = 0; i < n; i += 2)
+			m.insert(typename Map::value_type(bench::scattered(i, n), (int)i));
+		bench::report(name + " re-insert half", n / 2, bench::now_us() - start);
+
+		start = bench::now_us();
+		m.clear();
+		bench::report(name + " clear", n, bench::now_us() - start);
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg(argc, argv, 1, 1000000);
+
+	std::cout << "elements: " << n << std::endl;
+	run< ft::map<int, int> >("ft::map", n);
+	run< std::map<int, int> >("std::map", n);
+	return 0;
+}
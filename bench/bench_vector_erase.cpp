@@ -0,0 +1,72 @@
+/*
+	Erasing from the middle of an ft::vector of heavy elements:
+	1M std::string of 32 characters (heap allocated), and a counted element
+	type that reports how many copies, assignments and destructions every
+	shifted element costs.
+
+	usage: ./bench_vector_erase [elements] [erasures]
+*/
+
+#include "bench.hpp"
+#include "vector.hpp"
+
+struct counted {
+	static size_t	copies;
+	static size_t	assignments;
+	static size_t	destructions;
+	int				value;
+
+	counted(int v = 0) : value(v) {}
+	counted(const counted& other) : value(other.value) { ++copies; }
+	counted& operator=(const counted& other) { value = other.value; ++assignments; return *this; }
+	~counted() { ++destructions; }
+};
+
+size_t counted::copies = 0;
+size_t counted::assignments = 0;
+size_t counted::destructions = 0;
+
+int main(int argc, char** argv) {
+	size_t		n = bench::arg(argc, argv, 1, 1000000);
+	size_t		erasures = bench::arg(argc, argv, 2, 100);
+	long long	start;
+
+	{
+		ft::vector<std::string>	v;
+		v.reserve(n);
+		for (size_t i = 0; i < n; ++i)
+			v.push_back(std::string(32, (char)('a' + i % 26)));
+
+		start = bench::now_us();
+		for (size_t i = 0; i < erasures; ++i)
+			v.erase(v.begin() + v.size() / 2);
+		bench::report("erase(middle), std::string", erasures * n / 2, bench::now_us() - start);
+
+		start = bench::now_us();
+		for (size_t i = 0; i < erasures; ++i)
+			v.insert(v.begin() + v.size() / 2, std::string(32, 'z'));
+		bench::report("insert(middle) within capacity, std::string", erasures * n / 2, bench::now_us() - start);
+		bench::keep(v[n / 2].size());
+	}
+
+	{
+		ft::vector<counted>		v;
+		v.reserve(n);
+		for (size_t i = 0; i < n; ++i)
+			v.push_back(counted((int)i));
+		counted::copies = 0;
+		counted::assignments = 0;
+		counted::destructions = 0;
+
+		size_t	shifted = 0;
+		for (size_t i = 0; i < erasures; ++i) {
+			shifted += v.size() - v.size() / 2 - 1;
+			v.erase(v.begin() + v.size() / 2);
+		}
+		std::cout << "erase(middle), per shifted element: "
+				  << std::setprecision(3) << (double)counted::copies / (double)shifted << " copies, "
+				  << (double)counted::assignments / (double)shifted << " assignments, "
+				  << (double)counted::destructions / (double)shifted << " destructions" << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,61 @@
+/*
+	Growing an ft::vector<int> by push_back under every growth policy,
+	from empty and from an odd-sized vector of 1000 elements:
+	number of reallocations, peak bytes held by the allocator and final capacity.
+	Also prints the capacities each policy picks past 4G elements,
+	where the old int arithmetic used to overflow.
+
+	usage: ./bench_vector_growth [elements]
+*/
+
+#include "bench.hpp"
+#include "vector.hpp"
+
+#include <limits>
+
+template<class Growth>
+static void run(const std::string& name, size_t n, size_t initial) {
+	bench::alloc_stats::reset();
+
+	long long	start = bench::now_us();
+	{
+		ft::vector<int, bench::counting_allocator<int>, Growth>	v(initial);
+		for (size_t i = initial; i < n; ++i)
+			v.push_back((int)i);
+		bench::report(name, n, bench::now_us() - start);
+		std::cout << "    reallocations: " << bench::alloc_stats::calls
+				  << ", peak: " << bench::alloc_stats::peak / 1024 << " KiB"
+				  << ", capacity: " << v.capacity()
+				  << " (" << std::setprecision(1) << 100.0 * (double)(v.capacity() - v.size()) / (double)v.capacity() << "% unused)" << std::endl;
+	}
+}
+
+template<class Growth>
+static void past_4g(const std::string& name) {
+	const size_t	max = std::numeric_limits<size_t>::max() / sizeof(int);
+	size_t			cap = (size_t(1) << 32) - 3;
+
+	std::cout << "    " << name << ":";
+	for (int i = 0; i < 3; ++i) {
+		cap = Growth::template next<int>(cap, cap + 1, max);
+		std::cout << " " << cap;
+	}
+	std::cout << ", at max: " << (Growth::template next<int>(max - 1, max, max) == max ? "max" : "OVERFLOW") << std::endl;
+}
+
+int main(int argc, char** argv) {
+	size_t	n = bench::arg(argc, argv, 1, 50000000);
+
+	run<ft::growth_factor_2>("push_back, growth_factor_2", n, 0);
+	run<ft::growth_factor_1_5>("push_back, growth_factor_1_5", n, 0);
+	run<ft::growth_pow2>("push_back, growth_pow2", n, 0);
+	run<ft::growth_factor_2>("from 1000 elements, growth_factor_2", n, 1000);
+	run<ft::growth_factor_1_5>("from 1000 elements, growth_factor_1_5", n, 1000);
+	run<ft::growth_pow2>("from 1000 elements, growth_pow2", n, 1000);
+
+	std::cout << "capacities picked from 2^32 - 3 on:" << std::endl;
+	past_4g<ft::growth_factor_2>("growth_factor_2");
+	past_4g<ft::growth_factor_1_5>("growth_factor_1_5");
+	past_4g<ft::growth_pow2>("growth_pow2");
+	return 0;
+}
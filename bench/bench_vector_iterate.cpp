@@ -0,0 +1,103 @@
+/*
+	Walking an ft::vector<float> of 100M elements through its iterators against
+	operator[]: a sum, which the compiler cannot reorder, and an in-place scale,
+	which it can vectorise. Both columns should run at the same speed.
+	The chunked sum hands every 16 elements to a function the compiler cannot
+	inline, the way a generic algorithm receives its iterators: a trivially
+	copyable iterator travels in a register, one with a vtable through memory.
+	Also prints the size of the iterator next to the size of a pointer.
+
+	usage: ./bench_vector_iterate [elements] [passes]
+*/
+
+#include "bench.hpp"
+#include "vector.hpp"
+
+typedef ft::vector<float>	float_vector;
+
+static float sum_iterator(const float_vector& v) {
+	float	sum = 0;
+	for (float_vector::const_iterator it = v.begin(), ite = v.end(); it != ite; ++it)
+		sum += *it;
+	return sum;
+}
+
+static float sum_index(const float_vector& v) {
+	float	sum = 0;
+	for (size_t i = 0, n = v.size(); i < n; ++i)
+		sum += v[i];
+	return sum;
+}
+
+static void scale_iterator(float_vector& v) {
+	for (float_vector::iterator it = v.begin(), ite = v.end(); it != ite; ++it)
+		*it *= 0.5f;
+}
+
+static void scale_index(float_vector& v) {
+	for (size_t i = 0, n = v.size(); i < n; ++i)
+		v[i] *= 0.5f;
+}
+
+static float sum_range(float_vector::const_iterator first, float_vector::const_iterator last) {
+	float	sum = 0;
+	for (; first != last; ++first)
+		sum += *first;
+	return sum;
+}
+
+static float sum_range_index(const float_vector& v, size_t first, size_t last) {
+	float	sum = 0;
+	for (; first != last; ++first)
+		sum += v[first];
+	return sum;
+}
+
+/* called through volatile pointers so that they stay real calls */
+static float (*volatile g_sum_range)(float_vector::const_iterator, float_vector::const_iterator) = sum_range;
+static float (*volatile g_sum_range_index)(const float_vector&, size_t, size_t) = sum_range_index;
+
+static void chunked_iterator_pass(float_vector& v) {
+	const float_vector&	cv = v;
+	float				sum = 0;
+	for (size_t i = 0, n = cv.size(); i < n; i += 16)
+		sum += g_sum_range(cv.begin() + i, cv.begin() + (i + 16 < n ? i + 16 : n));
+	bench::keep(sum);
+}
+
+static void chunked_index_pass(float_vector& v) {
+	float	sum = 0;
+	for (size_t i = 0, n = v.size(); i < n; i += 16)
+		sum += g_sum_range_index(v, i, i + 16 < n ? i + 16 : n);
+	bench::keep(sum);
+}
+
+template<class Pass>
+static void run(const std::string& name, float_vector& v, size_t passes, Pass pass) {
+	long long	start = bench::now_us();
+	for (size_t p = 0; p < passes; ++p)
+		pass(v);
+	bench::report(name, v.size() * passes, bench::now_us() - start);
+}
+
+static void sum_iterator_pass(float_vector& v)	{ bench::keep(sum_iterator(v)); }
+static void sum_index_pass(float_vector& v)		{ bench::keep(sum_index(v)); }
+
+int main(int argc, char** argv) {
+	size_t	n = bench::arg(argc, argv, 1, 100000000);
+	size_t	passes = bench::arg(argc, argv, 2, 3);
+
+	std::cout << "elements: " << n << ", passes: " << passes
+			  << ", sizeof(iterator): " << sizeof(float_vector::iterator)
+			  << ", sizeof(float*): " << sizeof(float*) << std::endl;
+
+	float_vector	v(n, 1.0f);
+
+	run("sum through iterators", v, passes, sum_iterator_pass);
+	run("sum through operator[]", v, passes, sum_index_pass);
+	run("chunked sum through iterators", v, passes, chunked_iterator_pass);
+	run("chunked sum through operator[]", v, passes, chunked_index_pass);
+	run("scale through iterators", v, passes, scale_iterator);
+	run("scale through operator[]", v, passes, scale_index);
+	return 0;
+}
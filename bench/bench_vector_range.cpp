@@ -0,0 +1,67 @@
+/*
+	Range operations of ft::vector by iterator category:
+	constructing, assigning and inserting from another vector's range, where
+	ft::distance is a subtraction, and from a std::list, where it is a walk.
+	Then reading ints through std::istream_iterator, a single-pass range
+	that must not be measured before it is copied.
+
+	usage: ./bench_vector_range [elements] [repeats]
+*/
+
+#include "bench.hpp"
+#include "vector.hpp"
+
+#include <iterator>
+#include <list>
+#include <sstream>
+
+template<class Source>
+static void run(const std::string& name, const Source& src, size_t repeats) {
+	long long	start = bench::now_us();
+	size_t		total = 0;
+	for (size_t r = 0; r < repeats; ++r) {
+		ft::vector<int>	v(src.begin(), src.end());
+		total += v.size();
+	}
+	bench::report(name + " construct", total, bench::now_us() - start);
+
+	ft::vector<int>	v;
+	start = bench::now_us();
+	for (size_t r = 0; r < repeats; ++r)
+		v.assign(src.begin(), src.end());
+	bench::report(name + " assign", v.size() * repeats, bench::now_us() - start);
+
+	start = bench::now_us();
+	for (size_t r = 0; r < repeats; ++r) {
+		ft::vector<int>	w(4, 0);
+		w.insert(w.begin() + 2, src.begin(), src.end());
+		bench::keep(w.size());
+	}
+	bench::report(name + " insert", src.size() * repeats, bench::now_us() - start);
+}
+
+int main(int argc, char** argv) {
+	size_t	n = bench::arg(argc, argv, 1, 1000000);
+	size_t	repeats = bench::arg(argc, argv, 2, 50);
+
+	ft::vector<int>		vec;
+	std::list<int>		list;
+	std::ostringstream	text;
+	for (size_t i = 0; i < n; ++i) {
+		vec.push_back((int)i);
+		list.push_back((int)i);
+		text << i << ' ';
+	}
+
+	std::cout << "elements: " << n << ", repeats: " << repeats << std::endl;
+	run("from ft::vector", vec, repeats);
+	run("from std::list", list, repeats);
+
+	std::istringstream	in(text.str());
+	long long			start = bench::now_us();
+	ft::vector<int>		parsed((std::istream_iterator<int>(in)), std::istream_iterator<int>());
+	bench::report("from std::istream_iterator construct", parsed.size(), bench::now_us() - start);
+	std::cout << "    read " << parsed.size() << " of " << n << " ints, last = "
+			  << (parsed.empty() ? -1 : parsed.back()) << std::endl;
+	return 0;
+}
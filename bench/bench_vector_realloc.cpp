@@ -0,0 +1,47 @@
+/*
+	Growing an ft::vector<double> by push_back up to a given size in MiB (8 GiB by default),
+	with std::allocator (allocate + copy + free on every growth) and with
+	ft::realloc_allocator (the buffer is grown in place by realloc/mremap).
+	Reports the time, the time spent in growth steps alone and the peak RSS.
+	The default needs a bit more than 8 GiB of free memory.
+
+	usage: ./bench_vector_realloc [MiB]
+*/
+
+#include "bench.hpp"
+#include "vector.hpp"
+
+template<class Alloc>
+static void run(const std::string& name, size_t n) {
+	long long	grow_us = 0;
+	size_t		grows = 0;
+
+	bench::reset_peak_rss();
+	long long	start = bench::now_us();
+	{
+		ft::vector<double, Alloc>	v;
+		for (size_t i = 0; i < n; ++i) {
+			if (v.size() == v.capacity()) {
+				long long	t = bench::now_us();
+				v.push_back((double)i);
+				grow_us += bench::now_us() - t;
+				++grows;
+			}
+			else
+				v.push_back((double)i);
+		}
+		bench::report(name, n, bench::now_us() - start);
+		bench::keep(v[n / 2]);
+	}
+	std::cout << "    " << grows << " growths taking " << grow_us / 1000 << " ms"
+			  << ", peak rss " << bench::peak_rss_kb() / 1024 << " MiB" << std::endl;
+}
+
+int main(int argc, char** argv) {
+	size_t	mib = bench::arg(argc, argv, 1, 8192);
+	size_t	n = (mib << 20) / sizeof(double);
+
+	run< std::allocator<double> >("push_back, std::allocator", n);
+	run< ft::realloc_allocator<double> >("push_back, ft::realloc_allocator", n);
+	return 0;
+}
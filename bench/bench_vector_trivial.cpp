@@ -0,0 +1,42 @@
+/*
+	Moving ints around in a large ft::vector<int>: growth by push_back,
+	an explicit reserve, front insertion and front erasure,
+	all of which relocate the whole buffer.
+
+	usage: ./bench_vector_trivial [elements] [front operations]
+*/
+
+#include "bench.hpp"
+#include "vector.hpp"
+
+int main(int argc, char** argv) {
+	size_t				n = bench::arg(argc, argv, 1, 100000000);
+	size_t				front = bench::arg(argc, argv, 2, 8);
+	ft::vector<int>		v;
+	long long			start;
+
+	start = bench::now_us();
+	for (size_t i = 0; i < n; ++i)
+		v.push_back((int)i);
+	bench::report("push_back growth", n, bench::now_us() - start);
+
+	start = bench::now_us();
+	v.reserve(v.capacity() + 1);
+	bench::report("reserve(capacity() + 1)", v.size(), bench::now_us() - start);
+
+	start = bench::now_us();
+	for (size_t i = 0; i < front; ++i)
+		v.insert(v.begin(), (int)i);
+	bench::report("insert at begin()", front * v.size(), bench::now_us() - start);
+
+	start = bench::now_us();
+	for (size_t i = 0; i < front; ++i)
+		v.erase(v.begin());
+	bench::report("erase begin()", front * v.size(), bench::now_us() - start);
+
+	start = bench::now_us();
+	ft::vector<int>		filled(n, 0);
+	bench::report("fill constructor", n, bench::now_us() - start);
+	bench::keep(v[n / 2] + filled[n / 2]);
+	return 0;
+}
@@ -0,0 +1,55 @@
+/*
+ABOUT:
+	growth policies - how much ft::vector asks for when it runs out of room
+
+	Every growing path of the vector (push_back, the three insert overloads, resize)
+	calls Growth::next(capacity, required, max) and allocates exactly what it returns.
+	next() never returns less than required nor more than max, and never overflows:
+	the caller has already checked required <= max.
+
+	growth_factor_2		capacity * 2, the classic amortised O(1) push_back
+	growth_factor_1_5	capacity * 3 / 2, lets a freed block be reused by a later growth
+	growth_pow2			rounds the block size in bytes up to a power of two,
+						which is the size class most allocators hand out anyway
+*/
+
+#ifndef GROWTH_POLICY_HPP
+#define GROWTH_POLICY_HPP
+
+#include <cstddef>
+
+namespace ft {
+
+	struct growth_factor_2 {
+		template<class T>
+		static size_t next(size_t capacity, size_t required, size_t max) {
+			size_t grown = (capacity > max / 2) ? max : capacity * 2;
+			return (grown < required) ? required : grown;
+		}
+	};
+
+	struct growth_factor_1_5 {
+		template<class T>
+		static size_t next(size_t capacity, size_t required, size_t max) {
+			size_t grown = (capacity > max - capacity / 2) ? max : capacity + capacity / 2;
+			return (grown < required) ? required : grown;
+		}
+	};
+
+	struct growth_pow2 {
+		template<class T>
+		static size_t next(size_t capacity, size_t required, size_t max) {
+			size_t wanted = growth_factor_2::next<T>(capacity, required, max);
+			if (wanted > size_t(-1) / sizeof(T))
+				return wanted;
+			size_t bytes = 1;
+			while (bytes < wanted * sizeof(T) && bytes <= size_t(-1) / 2)
+				bytes *= 2;
+			size_t rounded = bytes / sizeof(T);
+			return (rounded < wanted || rounded > max) ? wanted : rounded;
+		}
+	};
+
+}
+
+#endif
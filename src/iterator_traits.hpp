@@ -11,13 +11,20 @@ This makes it possible to implement algorithms only in terms of iterators.
 #ifndef ITERATOR_HPP
 #define ITERATOR_HPP
 
+#include <cstddef>
+#include <iterator>
+
+#include "utils.hpp"
+
 namespace ft {
 
-	struct	input_iterator_tag {};
-	struct	output_iterator_tag {};
-	struct	forward_iterator_tag : public input_iterator_tag {};
-	struct	bidirectional_iterator_tag : public forward_iterator_tag {};
-	struct	random_access_iterator_tag : public bidirectional_iterator_tag {};
+// The tags are the standard ones, so that ft and std iterators
+// dispatch through the same hierarchy.
+	typedef std::input_iterator_tag				input_iterator_tag;
+	typedef std::output_iterator_tag			output_iterator_tag;
+	typedef std::forward_iterator_tag			forward_iterator_tag;
+	typedef std::bidirectional_iterator_tag		bidirectional_iterator_tag;
+	typedef std::random_access_iterator_tag		random_access_iterator_tag;
 
 
 	template<class Iterator>
@@ -62,13 +69,76 @@ namespace ft {
 	};
 
 
+// Trait class that identifies iterators which can be walked more than once
+// (forward, bidirectional or random access).
+	template<class Iterator>
+	struct _is_forward_iterator_helper {
+		static char test(const ft::forward_iterator_tag&);
+		static long test(...);
+		static typename ft::iterator_traits<Iterator>::iterator_category category();
+	};
+
+	template<class Iterator>
+	struct is_forward_iterator : public ft::integral_constant<bool,
+		sizeof(_is_forward_iterator_helper<Iterator>::test(_is_forward_iterator_helper<Iterator>::category())) == 1> {};
+
+
 	template<class InputIterator>
 	typename ft::iterator_traits<InputIterator>::difference_type
-	distance(InputIterator first, InputIterator last) {
+	_distance(InputIterator first, InputIterator last, ft::input_iterator_tag) {
 		typename ft::iterator_traits<InputIterator>::difference_type ret = 0;
-		for(; first != last; first++, ret++);
+		for(; first != last; ++first, ++ret);
 		return ret;
+	}
+
+	template<class RandomIt>
+	typename ft::iterator_traits<RandomIt>::difference_type
+	_distance(RandomIt first, RandomIt last, ft::random_access_iterator_tag) {
+		return last - first;
+	}
+
+	template<class InputIterator>
+	typename ft::iterator_traits<InputIterator>::difference_type
+	distance(InputIterator first, InputIterator last) {
+		return ft::_distance(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
 	};
+
+
+	template<class InputIterator, class Distance>
+	void _advance(InputIterator& it, Distance n, ft::input_iterator_tag) {
+		for (; n > 0; --n)
+			++it;
+	}
+
+	template<class BidirIt, class Distance>
+	void _advance(BidirIt& it, Distance n, ft::bidirectional_iterator_tag) {
+		for (; n > 0; --n)
+			++it;
+		for (; n < 0; ++n)
+			--it;
+	}
+
+	template<class RandomIt, class Distance>
+	void _advance(RandomIt& it, Distance n, ft::random_access_iterator_tag) {
+		it += n;
+	}
+
+	template<class InputIterator, class Distance>
+	void advance(InputIterator& it, Distance n) {
+		ft::_advance(it, n, typename ft::iterator_traits<InputIterator>::iterator_category());
+	}
+
+	template<class InputIterator>
+	InputIterator next(InputIterator it, typename ft::iterator_traits<InputIterator>::difference_type n = 1) {
+		ft::advance(it, n);
+		return it;
+	}
+
+	template<class BidirIt>
+	BidirIt prev(BidirIt it, typename ft::iterator_traits<BidirIt>::difference_type n = 1) {
+		ft::advance(it, -n);
+		return it;
+	}
 }
 
 #endif
@@ -2,9 +2,15 @@
 #include "map.hpp"
 #include "stack.hpp"
 #include "set.hpp"
+#include "small_vector.hpp"
+#include "static_vector.hpp"
+#include <algorithm>
 
 #include <iostream>
+#include <iterator>
+#include <sstream>
 #include <sys/time.h>
+#include <vector>
 
 # define GREEN "\e[92m"
 # define YELLOW "\e[93m"
@@ -51,6 +57,109 @@ static void printMapRev(M container) {
 	std::cout << GREEN << "}" << RESET << std::endl;
 }
 
+/* twelve bytes, the size growth_pow2 rounds up to whole powers of two */
+struct triple {
+	int	a, b, c;
+
+	triple(int value = 0) : a(value), b(value), c(value) {}
+	bool operator==(const triple& rhs) const { return a == rhs.a && b == rhs.b && c == rhs.c; }
+};
+
+/* pushes count elements, prints every capacity the vector goes through, then grows it by
+	an insert past what the policy would give, and tells whether the elements survived every reallocation */
+template <typename V>
+static void printGrowth(const std::string& name, int count, int extra) {
+	V		vct;
+	size_t	capacity = vct.capacity();
+	bool	intact = true;
+
+	std::cout << name << ":";
+	for (int i = 0; i < count; ++i) {
+		vct.push_back(typename V::value_type(i));
+		if (vct.capacity() == capacity)
+			continue;
+		capacity = vct.capacity();
+		std::cout << " " << capacity;
+		for (int j = 0; j <= i; ++j)
+			intact = intact && vct[j] == typename V::value_type(j);
+	}
+	vct.insert(vct.begin() + count / 2, extra, typename V::value_type(-1));
+	for (int j = 0; j < count + extra; ++j)
+		intact = intact && vct[j] == typename V::value_type(j < count / 2 ? j : j < count / 2 + extra ? -1 : j - extra);
+	std::cout << ", after inserting " << extra << ": " << vct.capacity() << ", elements intact: " << intact << std::endl;
+}
+
+/* sums what the mapped pointers point to, which the map does not see change */
+struct pointee_sum {
+	typedef long	summary_type;
+
+	static long identity()											{ return 0; }
+	static long of(const ft::pair<const int, const long*>& value)	{ return *value.second; }
+	static long combine(long lhs, long rhs)							{ return lhs + rhs; }
+};
+
+/* counts its default constructions */
+struct defaulted {
+	static long	defaults;
+	int			value;
+
+	defaulted() : value() { ++defaults; }
+};
+
+long defaulted::defaults = 0;
+
+/* counts what goes through it, the id tells copies of different allocators apart */
+long g_alloc_calls = 0;
+long g_alloc_live = 0;
+
+template <typename T>
+struct counting_allocator : public std::allocator<T> {
+	typedef typename std::allocator<T>::pointer		pointer;
+	typedef typename std::allocator<T>::size_type	size_type;
+
+	template <typename U>
+	struct rebind { typedef counting_allocator<U> other; };
+
+	int	id;
+
+	counting_allocator(int id = 0) : std::allocator<T>(), id(id) {}
+	template <typename U>
+	counting_allocator(const counting_allocator<U>& other) : std::allocator<T>(), id(other.id) {}
+
+	pointer allocate(size_type n, const void* = 0) {
+		++g_alloc_calls;
+		g_alloc_live += n * sizeof(T);
+		return std::allocator<T>::allocate(n);
+	}
+
+	void deallocate(pointer p, size_type n) {
+		g_alloc_live -= n * sizeof(T);
+		std::allocator<T>::deallocate(p, n);
+	}
+};
+
+template <typename T, typename U>
+bool operator==(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) { return lhs.id == rhs.id; }
+template <typename T, typename U>
+bool operator!=(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) { return lhs.id != rhs.id; }
+
+#if __cplusplus >= 201103L
+/* counts its copies, a move is free and cannot throw */
+struct tracked {
+	static long	copies;
+	int			value;
+
+	tracked(int value = 0) : value(value) {}
+	tracked(const tracked& other) : value(other.value) { ++copies; }
+	tracked(tracked&& other) noexcept : value(other.value) {}
+	tracked& operator=(const tracked& other) { value = other.value; ++copies; return *this; }
+	tracked& operator=(tracked&& other) noexcept { value = other.value; return *this; }
+	bool operator<(const tracked& rhs) const { return value < rhs.value; }
+};
+
+long tracked::copies = 0;
+#endif
+
 int main() {
 
 	{
@@ -219,6 +328,74 @@ int main() {
 			std::cout << "\nvector containes: ";
 			printVec (vct);
 		}
+		{
+			std::cout << USCORED << "\ntest growth policies, capacities while pushing 100 elements:\n" << RESET;
+			printGrowth<ft::vector<int, std::allocator<int>, ft::growth_factor_2> >("growth_factor_2", 100, 300);
+			printGrowth<ft::vector<int, std::allocator<int>, ft::growth_factor_1_5> >("growth_factor_1_5", 100, 300);
+			printGrowth<ft::vector<int, std::allocator<int>, ft::growth_pow2> >("growth_pow2, int", 100, 300);
+			printGrowth<ft::vector<triple, std::allocator<triple>, ft::growth_pow2> >("growth_pow2, 12 bytes", 100, 300);
+		}
+
+		{
+			std::cout << USCORED << "\ntest vector with realloc_allocator, reserve, insert in the middle, erase:\n" << RESET;
+			ft::vector<int, ft::realloc_allocator<int> >	vct;
+			std::vector<int>								ref;
+			bool											same = true;
+
+			for (int step = 0; step < 8; ++step) {
+				switch (step) {
+					case 0: vct.reserve(10); ref.reserve(10); break;
+					case 1: for (int i = 0; i < 20; ++i) { vct.push_back(i); ref.push_back(i); } break;
+					case 2: vct.insert(vct.begin() + 10, 100, 42); ref.insert(ref.begin() + 10, 100, 42); break;
+					case 3: vct.insert(vct.begin() + 5, -5); ref.insert(ref.begin() + 5, -5); break;
+					case 4: vct.reserve(1000); ref.reserve(1000); break;
+					case 5: vct.erase(vct.begin() + 8, vct.begin() + 115); ref.erase(ref.begin() + 8, ref.begin() + 115); break;
+					case 6: vct.erase(vct.begin()); ref.erase(ref.begin()); break;
+					case 7: { std::vector<int> copy(ref); vct.insert(vct.begin() + 4, copy.begin(), copy.end()); ref.insert(ref.begin() + 4, copy.begin(), copy.end()); } break;
+				}
+				same = same && vct.size() == ref.size() && std::equal(ref.begin(), ref.end(), vct.begin());
+			}
+			std::cout << "same as std::vector after every step: " << same << std::endl;
+			printVec(vct);
+		}
+
+		{
+			std::cout << USCORED << "\ntest static_vector filled to capacity:\n" << RESET;
+			ft::static_vector<int, 8, ft::overflow_report>	reporting;
+			for (int i = 0; i < 8; ++i)
+				reporting.push_back(i * 10);
+			std::cout << "full: " << reporting.full() << ", try_push_back(80): " << reporting.try_push_back(80)
+					  << ", overflowed: " << reporting.overflowed() << std::endl;
+			reporting.push_back(80);
+			std::cout << "after push_back(80), overflowed: " << reporting.overflowed() << ", size: " << reporting.size() << std::endl;
+			reporting.reset_overflow();
+			reporting.insert(reporting.begin() + 3, 2, 35);
+			std::cout << "after insert of 2 in the middle, overflowed: " << reporting.overflowed() << ", size: " << reporting.size() << std::endl;
+			printVec(reporting);
+
+			ft::static_vector<int, 8>	throwing(reporting.begin(), reporting.end());
+			bool						threw = false;
+			std::cout << "try_push_back(80): " << throwing.try_push_back(80) << std::endl;
+			try {
+				throwing.push_back(80);
+			} catch (std::length_error&) {
+				threw = true;
+			}
+			std::cout << "push_back(80) threw length_error: " << threw << ", size: " << throwing.size() << std::endl;
+			printVec(throwing);
+		}
+
+		{
+			std::cout << USCORED << "\ntest vector from std::istream_iterator, single pass input:\n" << RESET;
+			std::istringstream			numbers("1 2 3 4 5 6 7");
+			std::istringstream			more("-1 -2 -3");
+			ft::vector<int>				vct((std::istream_iterator<int>(numbers)), std::istream_iterator<int>());
+			printVec(vct);
+			vct.insert(vct.begin() + 2, std::istream_iterator<int>(more), std::istream_iterator<int>());
+			std::cout << "size after range insert: " << vct.size() << std::endl;
+			printVec(vct);
+		}
+
 
 		std::cout << GREEN << "\ntotal time spent on ft::vector testing = " << get_timestamp() - g_timestamp << " μs" << RESET << std::endl;;
 
@@ -239,7 +416,7 @@ int main() {
 			map_orig[5] = "ccc";
 			std::cout << "map size = " << map_orig.size() << std::endl;
 			std::cout << "map empty? = " << map_orig.empty() << std::endl;
-			std::cout << "map maxsize = " << map_orig.max_size() << std::endl;
+			std::cout << "map maxsize fits a million nodes = " << (map_orig.max_size() > 1000000) << std::endl;
 			std::cout << "\nmap containes: ";
 			printMap(map_orig);
 			std::cout << "\nreversed map containes: ";
@@ -325,6 +502,85 @@ int main() {
 			printMapRev(mp);
 		}
 
+		{
+			std::cout << USCORED << "\ntest custom allocator:\n" << RESET;
+			typedef counting_allocator< ft::pair<const int, std::string> >							counted_pair_allocator;
+			typedef ft::map<int, std::string, std::less<int>, counted_pair_allocator>	counted_map;
+			g_alloc_calls = 0;
+			{
+				counted_map	mp(std::less<int>(), counted_pair_allocator(42));
+				for (int i = 0; i < 100; ++i)
+					mp[i] = "x";
+				counted_map	cpy(mp);
+				std::cout << "nodes allocated through the allocator = " << (g_alloc_calls > 0) << std::endl;
+				std::cout << "allocator id of map and copy = " << mp.get_allocator().id << ", " << cpy.get_allocator().id << std::endl;
+				std::cout << "memory in use = " << (g_alloc_live > 0) << std::endl;
+			}
+			std::cout << "memory in use after destruction = " << g_alloc_live << std::endl;
+		}
+
+		{
+			std::cout << USCORED << "\ntest sorted_unique construction and insert:\n" << RESET;
+			ft::pair<int, std::string>	sorted[6];
+			for (int i = 0; i < 6; ++i)
+				sorted[i] = ft::make_pair(i * 3, std::string(1, char('a' + i)));
+			ft::map<int, std::string>	built(ft::sorted_unique, sorted, sorted + 6);
+			ft::map<int, std::string>	inserted(sorted, sorted + 6);
+			std::cout << "built size = " << built.size() << ", same as a range insert = " << (built == inserted) << std::endl;
+			printMap(built);
+			ft::map<int, std::string>	none(ft::sorted_unique, sorted, sorted);
+			none.insert(ft::sorted_unique, sorted + 2, sorted + 2);
+			std::cout << "from empty ranges size = " << none.size() << ", empty = " << none.empty() << std::endl;
+			ft::map<int, std::string>	target;
+			target[4] = "x";
+			target[6] = "y";
+			target[20] = "z";
+			ft::map<int, std::string>	expected(target);
+			target.insert(ft::sorted_unique, sorted, sorted + 6);
+			expected.insert(sorted, sorted + 6);
+			std::cout << "into a non-empty map size = " << target.size() << ", same as a range insert = " << (target == expected) << std::endl;
+			printMap(target);
+		}
+
+		{
+			std::cout << USCORED << "\ntest try_insert:\n" << RESET;
+			ft::map<int, std::string>						mp;
+			mp[1] = "one";
+			ft::pair<ft::map<int, std::string>::iterator, bool>	ret = mp.try_insert(1, "uno");
+			std::cout << "present: inserted = " << ret.second << ", key = " << ret.first->first << ", value = " << ret.first->second << std::endl;
+			ret = mp.try_insert(2, "two");
+			std::cout << "missing: inserted = " << ret.second << ", key = " << ret.first->first << ", value = " << ret.first->second << std::endl;
+			std::cout << "size = " << mp.size() << ", mp[1] = " << mp[1] << std::endl;
+			printMap(mp);
+		}
+		{
+			std::cout << USCORED << "\ntest next, prev and advance on map iterators:\n" << RESET;
+			ft::map<int, int>	mp;
+			for (int i = 0; i < 10; ++i)
+				mp[i * 10] = i;
+			ft::map<int, int>::iterator			it = mp.begin();
+			ft::map<int, int>::const_iterator	cit = mp.end();
+			std::cout << "next(begin()): " << ft::next(it)->first << ", next(begin(), 4): " << ft::next(it, 4)->first << std::endl;
+			std::cout << "prev(end()): " << ft::prev(cit)->first << ", prev(end(), 3): " << ft::prev(cit, 3)->first << std::endl;
+			std::cout << "next(end(), -2): " << ft::next(cit, -2)->first << ", prev(begin(), -5): " << ft::prev(it, -5)->first << std::endl;
+			ft::advance(it, 7);
+			std::cout << "advance(it, 7): " << it->first;
+			ft::advance(it, -3);
+			std::cout << ", advance(it, -3): " << it->first;
+			ft::advance(it, 0);
+			std::cout << ", advance(it, 0): " << it->first << std::endl;
+			std::cout << "distance(begin(), it): " << ft::distance(mp.begin(), it) << ", distance(it, end()): " << ft::distance(it, mp.end()) << std::endl;
+		}
+
+		{
+			std::cout << USCORED << "\ntest operator[] builds a mapped value on a miss only:\n" << RESET;
+			ft::map<int, defaulted>	m;
+			m[1].value = 10;
+			long					after_miss = defaulted::defaults;
+			m[1].value += 5;
+			std::cout << "default constructions, miss: " << after_miss << ", hits: " << defaulted::defaults - after_miss << ", value: " << m[1].value << std::endl;
+		}
+
 
 		std::cout << GREEN << "\ntotal time spent on ft::map testing = " << get_timestamp() - g_timestamp << " μs" << RESET << std::endl;;
 
@@ -348,6 +604,28 @@ int main() {
 		stack_my.pop();
 		stack_my.pop();
 		std::cout << "stack top after pop = " << stack_my.top() << std::endl;
+
+		std::cout << USCORED << "\ntest stack over a small container:\n" << RESET;
+		ft::stack<int, ft::small_vector<int, 4> > stack_small;
+		for (int i = 0; i < 10; ++i)
+			stack_small.push(i * 3);
+		ft::stack<int, ft::small_vector<int, 4> > stack_copy(stack_small);
+		while (stack_small.size() > 2)
+			stack_small.pop();
+		std::cout << "size = " << stack_small.size() << ", top = " << stack_small.top() << std::endl;
+		std::cout << "copy size = " << stack_copy.size() << ", top = " << stack_copy.top() << std::endl;
+		std::cout << "small < copy? -> " << std::boolalpha << (stack_small < stack_copy) << std::endl;
+		stack_copy = stack_small;
+		std::cout << "equal after assignment? -> " << (stack_copy == stack_small) << std::endl;
+
+		std::cout << USCORED << "\ntest stack over a bounded container:\n" << RESET;
+		ft::stack<int, ft::static_vector<int, 16> > stack_bounded;
+		for (int i = 0; i < 16; ++i)
+			stack_bounded.push(i);
+		std::cout << "size = " << stack_bounded.size() << ", top = " << stack_bounded.top() << std::endl;
+		stack_bounded.pop();
+		stack_bounded.push(-1);
+		std::cout << "top after pop and push = " << stack_bounded.top() << std::endl;
 		
 		std::cout << GREEN << "\ntotal time spent on ft::stack testing = " << get_timestamp() - g_timestamp << " μs" << RESET << std::endl;;
 		
@@ -451,8 +729,414 @@ int main() {
 		std::cout << "the upper bound points to: " << *ret.second << '\n';
 	}
 
+	std::cout << "\ntest sorted_unique\n";
+	{
+		int				sorted[] = { 1, 4, 9, 16, 25 };
+		ft::set<int>	built(ft::sorted_unique, sorted, sorted + 5);
+		ft::set<int>	inserted(sorted, sorted + 5);
+		ft::set<int>	none(ft::sorted_unique, sorted, sorted);
+		ft::set<int>	target;
+		target.insert(9);
+		target.insert(30);
+		target.insert(ft::sorted_unique, sorted, sorted + 5);
+		std::cout << "same as a range insert = " << (built == inserted) << ", size = " << built.size() << ", from an empty range = " << none.size() << "\n";
+		for (ft::set<int>::iterator it = target.begin(); it != target.end(); ++it)
+			std::cout << *it << " ";
+		std::cout << "\n";
+	}
+
+	std::cout << "\ntest custom allocator\n";
+	{
+		typedef ft::set<int, std::less<int>, counting_allocator<int> >	counted_set;
+		g_alloc_calls = 0;
+		{
+			counted_set	s0(std::less<int>(), counting_allocator<int>(7));
+			for (int i = 0; i < 1000; ++i)
+				s0.insert(i);
+			s0.erase(s0.begin(), s0.find(500));
+			std::cout << "nodes allocated through the allocator = " << (g_alloc_calls > 0) << "\n";
+			std::cout << "allocator id = " << s0.get_allocator().id << "\n";
+		}
+		std::cout << "memory in use after destruction = " << g_alloc_live << "\n";
+	}
+
 		std::cout << GREEN << "\ntotal time spent on ft::set testing = " << get_timestamp() - g_timestamp << " μs" << RESET << std::endl;;
 	}
 
+	{
+		std::cout << "----------- NODE HANDLE AND MERGE TESTING -----------" << std::endl;
+		g_timestamp = get_timestamp();
+
+		std::cout << USCORED << "\ntest map extract and insert of a node:\n" << RESET;
+		{
+			ft::map<int, std::string>	young;
+			ft::map<int, std::string>	old;
+			for (int i = 0; i < 8; ++i)
+				young[i] = std::string(1, char('a' + i));
+			old[3] = "old";
+			ft::map<int, std::string>::node_type			nh = young.extract(2);
+			std::cout << "extracted " << nh.key() << " -> " << nh.mapped() << ", young size = " << young.size() << std::endl;
+			ft::map<int, std::string>::insert_return_type	ret = old.insert(ft::move(nh));
+			std::cout << "inserted = " << ret.inserted << ", at " << ret.position->first << ", handle empty = " << nh.empty() << std::endl;
+			ret = old.insert(young.extract(young.find(3)));
+			std::cout << "inserted = " << ret.inserted << ", handed back " << ret.node.key() << " -> " << ret.node.mapped() << ", old[3] = " << old[3] << std::endl;
+			old.insert(old.end(), young.extract(--young.end()));
+			std::cout << "extract of a missing key is empty = " << young.extract(42).empty() << std::endl;
+			printMap(young);
+			printMap(old);
+		}
+
+		std::cout << USCORED << "\ntest a node outliving its map:\n" << RESET;
+		{
+			ft::map<int, std::string>::node_type	nh;
+			{
+				ft::map<int, std::string>	gone;
+				gone[7] = "survivor";
+				gone[8] = "erased";
+				nh = gone.extract(7);
+			}
+			ft::map<int, std::string>	target;
+			target.insert(ft::move(nh));
+			target[9] = "new";
+			printMap(target);
+		}
+
+		std::cout << USCORED << "\ntest map merge:\n" << RESET;
+		{
+			ft::map<int, int>	gen0;
+			ft::map<int, int>	gen1;
+			for (int i = 0; i < 1000; ++i) {
+				gen0[i * 2] = 0;
+				gen1[i * 3] = 1;
+			}
+			gen1.merge(gen0);
+			std::cout << "gen1 size = " << gen1.size() << ", gen0 size = " << gen0.size() << std::endl;
+			std::cout << "gen1[4] = " << gen1[4] << ", gen1[6] = " << gen1[6] << ", gen0 first = " << gen0.begin()->first << ", last = " << gen0.rbegin()->first << std::endl;
+			ft::map<int, int>	few;
+			few[-1] = 2;
+			few[0] = 2;
+			few[5000] = 2;
+			gen1.merge(few);
+			std::cout << "gen1 size = " << gen1.size() << ", few size = " << few.size() << ", gen1 first = " << gen1.begin()->first << ", last = " << gen1.rbegin()->first << std::endl;
+			gen0.clear();
+			gen1.erase(gen1.begin(), gen1.lower_bound(2990));
+			printMap(gen1);
+			gen0.merge(gen1);
+			std::cout << "gen0 size = " << gen0.size() << ", gen1 size = " << gen1.size() << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest set extract and merge:\n" << RESET;
+		{
+			ft::set<std::string>	a;
+			ft::set<std::string>	b;
+			a.insert("apple");
+			a.insert("pear");
+			b.insert("pear");
+			b.insert("fig");
+			b.insert("kiwi");
+			a.merge(b);
+			ft::set<std::string>::node_type	nh = a.extract("fig");
+			std::cout << "extracted " << nh.value() << std::endl;
+			b.insert(b.begin(), ft::move(nh));
+			for (ft::set<std::string>::iterator it = a.begin(); it != a.end(); ++it)
+				std::cout << *it << " ";
+			std::cout << "| ";
+			for (ft::set<std::string>::iterator it = b.begin(); it != b.end(); ++it)
+				std::cout << *it << " ";
+			std::cout << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest maps stay independent after extract and merge:\n" << RESET;
+		{
+			ft::map<int, std::string>	a;
+			ft::map<int, std::string>	b;
+			for (int i = 0; i < 6; ++i) {
+				a[i] = std::string(1, char('a' + i));
+				b[i + 10] = std::string(1, char('A' + i));
+			}
+			a.insert(b.extract(b.begin()));
+			a.insert(b.extract(12));
+			b.clear();
+			b[20] = "fresh";
+			printMap(a);
+			printMap(b);
+			for (int i = 0; i < 5; ++i)
+				b[i * 2] = "b";
+			a.merge(b);
+			printMap(b);
+			b.clear();
+			a.erase(a.begin());
+			a[30] = "late";
+			b[1] = "again";
+			printMap(a);
+			printMap(b);
+		}
+
+		std::cout << USCORED << "\ntest map split_off and append:\n" << RESET;
+		{
+			ft::map<int, int>	left;
+			for (int i = 0; i < 1000; ++i)
+				left[i * 2] = i;
+			ft::map<int, int>	right = left.split_off(1001);
+			std::cout << "left size = " << left.size() << ", last = " << left.rbegin()->first << ", right size = " << right.size() << ", first = " << right.begin()->first << std::endl;
+			ft::map<int, int>	tail = right.split_off(1900);
+			ft::map<int, int>	none = tail.split_off(5000);
+			ft::map<int, int>	all = left.split_off(-1);
+			std::cout << "right size = " << right.size() << ", tail size = " << tail.size() << ", none size = " << none.size() << ", left size = " << left.size() << ", all size = " << all.size() << std::endl;
+			all.append(tail);
+			std::cout << "all size = " << all.size() << ", tail size = " << tail.size() << ", last = " << all.rbegin()->first << std::endl;
+			right.append(all);
+			std::cout << "right size = " << right.size() << ", all size = " << all.size() << ", first = " << right.begin()->first << std::endl;
+			ft::map<int, int>	overlap;
+			overlap[-5] = -1;
+			overlap[4] = -1;
+			overlap[5] = -1;
+			right.append(overlap);
+			std::cout << "right size = " << right.size() << ", overlap size = " << overlap.size() << ", right[4] = " << right[4] << std::endl;
+			right.erase(right.begin(), right.lower_bound(1990));
+			printMap(right);
+		}
+
+		std::cout << USCORED << "\ntest maps stay independent after split_off and append:\n" << RESET;
+		{
+			ft::map<int, std::string>	whole;
+			for (int i = 0; i < 10; ++i)
+				whole[i] = std::string(1, char('a' + i));
+			ft::map<int, std::string>	high = whole.split_off(7);
+			ft::map<int, std::string>	low = whole.split_off(2);
+			low.swap(whole);
+			whole.clear();
+			whole[-1] = "z";
+			high[20] = "u";
+			low.erase(1);
+			printMap(whole);
+			printMap(low);
+			printMap(high);
+			low.append(high);
+			high.clear();
+			high[100] = "h";
+			whole.append(low);
+			low[50] = "l";
+			printMap(whole);
+			printMap(low);
+			printMap(high);
+		}
+
+		std::cout << USCORED << "\ntest set split_off and append:\n" << RESET;
+		{
+			ft::set<std::string>	words;
+			words.insert("delta");
+			words.insert("alpha");
+			words.insert("echo");
+			words.insert("bravo");
+			words.insert("charlie");
+			ft::set<std::string>	late = words.split_off("c");
+			ft::set<std::string>	early;
+			early.insert("a");
+			early.append(words);
+			for (ft::set<std::string>::iterator it = early.begin(); it != early.end(); ++it)
+				std::cout << *it << " ";
+			std::cout << "| ";
+			for (ft::set<std::string>::iterator it = late.begin(); it != late.end(); ++it)
+				std::cout << *it << " ";
+			std::cout << "| " << words.size() << std::endl;
+		}
+
+		std::cout << GREEN << "\ntotal time spent on node handle and merge testing = " << get_timestamp() - g_timestamp << " μs" << RESET << std::endl;;
+	}
+
+	{
+		std::cout << "----------- ORDER STATISTICS TESTING -----------" << std::endl;
+		g_timestamp = get_timestamp();
+
+		typedef ft::map<int, std::string, std::less<int>, std::allocator<int>, ft::tree_order_statistics>	ranked_map;
+		typedef ft::set<int, std::less<int>, std::allocator<int>, ft::tree_order_statistics>				ranked_set;
+
+		std::cout << USCORED << "\ntest map nth, rank and distance:\n" << RESET;
+		{
+			ranked_map	pages;
+			for (int i = 0; i < 500; ++i)
+				pages[(i * 37) % 1000] = std::string(1, char('a' + i % 26));
+			std::cout << "size = " << pages.size() << ", nth(0) = " << pages.nth(0)->first << ", nth(123) = " << pages.nth(123)->first
+					  << ", nth(499) = " << pages.nth(499)->first << ", nth(500) is end = " << (pages.nth(500) == pages.end()) << std::endl;
+			std::cout << "rank(-1) = " << pages.rank(-1) << ", rank(500) = " << pages.rank(500) << ", rank(501) = " << pages.rank(501) << ", rank(5000) = " << pages.rank(5000) << std::endl;
+			std::cout << "distance = " << pages.distance(pages.begin(), pages.end()) << ", " << pages.distance(pages.find(74), pages.lower_bound(700)) << std::endl;
+			for (int i = 0; i < 1000; i += 3)
+				pages.erase(i);
+			pages.insert(ft::make_pair(1, std::string("one")));
+			std::cout << "size = " << pages.size() << ", page 3 of 10:";
+			for (ranked_map::const_iterator it = pages.nth(20); it != pages.nth(30); ++it)
+				std::cout << " " << it->first << it->second;
+			std::cout << std::endl;
+			ranked_map	upper = pages.split_off(500);
+			const ranked_map&	const_pages = pages;
+			std::cout << "after split_off: nth(10) = " << const_pages.nth(10)->first << ", upper nth(10) = " << upper.nth(10)->first
+					  << ", upper rank(600) = " << upper.rank(600) << std::endl;
+			pages.append(upper);
+			ranked_map	copy(pages);
+			std::cout << "copy nth(200) = " << copy.nth(200)->first << ", rank(800) = " << copy.rank(800) << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest set nth, rank and distance:\n" << RESET;
+		{
+			ranked_set	scores;
+			for (int i = 0; i < 100; ++i)
+				scores.insert(i * i % 97);
+			std::cout << "size = " << scores.size() << ", median = " << *scores.nth(scores.size() / 2) << ", rank(50) = " << scores.rank(50)
+					  << ", distance = " << scores.distance(scores.find(4), scores.find(81)) << std::endl;
+		}
+
+		std::cout << GREEN << "\ntotal time spent on order statistics testing = " << get_timestamp() - g_timestamp << " μs" << RESET << std::endl;;
+	}
+
+	{
+		std::cout << "----------- RANGE AGGREGATE TESTING -----------" << std::endl;
+		g_timestamp = get_timestamp();
+
+		typedef ft::map<int, long, std::less<int>, std::allocator<int>, ft::tree_aggregate<ft::aggregate_sum<long> > >						sum_map;
+		typedef ft::map<int, int, std::less<int>, std::allocator<int>, ft::tree_aggregate<ft::aggregate_max<int>, ft::tree_order_statistics> >	max_map;
+		typedef ft::set<int, std::less<int>, std::allocator<int>, ft::tree_aggregate<ft::aggregate_min<int> > >								min_set;
+
+		std::cout << USCORED << "\ntest map aggregate of a sliding window:\n" << RESET;
+		{
+			sum_map	sums;
+			max_map	peaks;
+			for (int second = 0; second < 600; ++second) {
+				sums.insert_or_assign(second, (second * 7919) % 1000);
+				peaks.insert(ft::make_pair(second, (second * 104729) % 5000));
+			}
+			for (int end = 60; end <= 600; end += 90)
+				std::cout << "[" << end - 60 << ", " << end << ") sum = " << sums.aggregate(end - 60, end) << ", peak = " << peaks.aggregate(end - 60, end) << std::endl;
+			std::cout << "all = " << sums.aggregate(-1, 1000) << ", empty = " << sums.aggregate(300, 300) << ", reversed = " << sums.aggregate(400, 300)
+					  << ", outside = " << sums.aggregate(1000, 2000) << std::endl;
+			sums.erase(sums.begin(), sums.lower_bound(300));
+			peaks.erase(peaks.begin(), peaks.lower_bound(300));
+			sums.insert_or_assign(450, 1000000);
+			peaks.update(peaks.find(451), 99999);
+			std::cout << "after eviction: sum = " << sums.aggregate(0, 600) << ", [440, 460) sum = " << sums.aggregate(440, 460)
+					  << ", peak = " << peaks.aggregate(0, 600) << ", peak before 451 = " << peaks.aggregate(0, 451) << std::endl;
+			sum_map	tail = sums.split_off(500);
+			std::cout << "split: sum = " << sums.aggregate(0, 600) << ", tail sum = " << tail.aggregate(0, 600) << std::endl;
+			sums.append(tail);
+			sum_map	copy(sums);
+			std::cout << "joined copy: sum = " << copy.aggregate(0, 600) << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest refresh of an aggregate over pointers:\n" << RESET;
+		{
+			typedef ft::map<int, const long*, std::less<int>, std::allocator<int>, ft::tree_aggregate<pointee_sum> >	pointee_map;
+			long		balances[50];
+			pointee_map	accounts;
+			for (int i = 0; i < 50; ++i) {
+				balances[i] = i * 10;
+				accounts.insert(pointee_map::value_type(i, &balances[i]));
+			}
+			std::cout << "mapped values are const: " << ft::is_same<pointee_map::mapped_reference, const long* const&>::value
+					  << ", plain map: " << ft::is_same<ft::map<int, long>::mapped_reference, const long&>::value << std::endl;
+			std::cout << "sum = " << accounts.aggregate(0, 50) << ", [20, 30) sum = " << accounts.aggregate(20, 30) << std::endl;
+			balances[25] += 1000;
+			std::cout << "stale after a write elsewhere: sum = " << accounts.aggregate(0, 50) << ", [20, 30) sum = " << accounts.aggregate(20, 30) << std::endl;
+			accounts.refresh(accounts.find(25));
+			std::cout << "after refresh: sum = " << accounts.aggregate(0, 50) << ", [20, 30) sum = " << accounts.aggregate(20, 30) << std::endl;
+			accounts.update(accounts.find(26), &balances[0]);
+			std::cout << "after update: sum = " << accounts.aggregate(0, 50) << ", [20, 30) sum = " << accounts.aggregate(20, 30) << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest set aggregate:\n" << RESET;
+		{
+			min_set	lows;
+			for (int i = 0; i < 200; ++i)
+				lows.insert((i * 37) % 211 - 100);
+			std::cout << "min = " << lows.aggregate(-1000, 1000) << ", min of [0, 50) = " << lows.aggregate(0, 50) << ", min of [50, 51) = " << lows.aggregate(50, 51) << std::endl;
+		}
+
+		std::cout << GREEN << "\ntotal time spent on range aggregate testing = " << get_timestamp() - g_timestamp << " μs" << RESET << std::endl;;
+	}
+
+#if __cplusplus >= 201103L
+	{
+		std::cout << "----------- MOVE AND EMPLACE TESTING -----------" << std::endl;
+		g_timestamp = get_timestamp();
+
+		std::cout << USCORED << "\ntest vector growth moves its elements:\n" << RESET;
+		{
+			ft::vector<tracked>	vec;
+			tracked::copies = 0;
+			for (int i = 0; i < 1000; ++i)
+				vec.emplace_back(i);
+			vec.insert(vec.begin() + 10, tracked(-1));
+			vec.emplace(vec.begin(), -2);
+			std::cout << "size = " << vec.size() << ", front = " << vec.front().value << ", [11] = " << vec[11].value << std::endl;
+			std::cout << "copies while growing = " << tracked::copies << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest vector move constructor and assignment:\n" << RESET;
+		{
+			ft::vector<std::string>	vec;
+			vec.emplace_back(3, 'x');
+			vec.push_back(std::string("moved"));
+			vec.emplace(vec.begin() + 1, "middle");
+			ft::vector<std::string>	moved(std::move(vec));
+			std::cout << "source size = " << vec.size() << ", target: ";
+			printVec(moved);
+			ft::vector<std::string>	assigned(2, "old");
+			assigned = std::move(moved);
+			std::cout << "source size = " << moved.size() << ", target: ";
+			printVec(assigned);
+		}
+
+		std::cout << USCORED << "\ntest pair move:\n" << RESET;
+		{
+			ft::pair<std::string, std::string>	p("first", "second");
+			ft::pair<std::string, std::string>	q(std::move(p));
+			std::cout << "source = [" << p.first << ", " << p.second << "], target = [" << q.first << ", " << q.second << "]" << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest map emplace and move:\n" << RESET;
+		{
+			ft::map<int, std::string>	mp;
+			std::cout << "emplace(1, one) inserted = " << mp.emplace(1, "one").second << std::endl;
+			std::cout << "emplace(1, uno) inserted = " << mp.emplace(1, "uno").second << std::endl;
+			mp.emplace_hint(mp.end(), 3, "three");
+			mp.emplace_hint(mp.begin(), 2, "two");
+			mp.insert(ft::make_pair(4, std::string("four")));
+			mp.insert(mp.end(), ft::make_pair(5, std::string("five")));
+			printMap(mp);
+			ft::map<int, std::string>	moved(std::move(mp));
+			std::cout << "source size = " << mp.size() << ", target size = " << moved.size() << std::endl;
+			mp = std::move(moved);
+			std::cout << "source size = " << moved.size() << ", target size = " << mp.size() << std::endl;
+			ft::map<std::string, int>	words;
+			std::string					key("key");
+			words[std::move(key)] = 42;
+			std::cout << "words[key] = " << words["key"] << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest set emplace and move:\n" << RESET;
+		{
+			ft::set<tracked>	st;
+			tracked::copies = 0;
+			for (int i = 0; i < 100; ++i)
+				st.emplace(i % 50);
+			st.emplace_hint(st.end(), 100);
+			st.insert(tracked(101));
+			std::cout << "size = " << st.size() << ", copies = " << tracked::copies << std::endl;
+			ft::set<tracked>	moved(std::move(st));
+			std::cout << "source size = " << st.size() << ", target size = " << moved.size() << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest stack emplace and move:\n" << RESET;
+		{
+			ft::stack<std::string>	stack;
+			stack.emplace(2, 'a');
+			stack.push(std::string("top"));
+			ft::stack<std::string>	moved(std::move(stack));
+			std::cout << "source size = " << stack.size() << ", target top = " << moved.top() << ", size = " << moved.size() << std::endl;
+		}
+
+		std::cout << GREEN << "\ntotal time spent on move and emplace testing = " << get_timestamp() - g_timestamp << " μs" << RESET << std::endl;;
+	}
+#endif
+
 	return 0;
 }
@@ -5,6 +5,11 @@
 #include <map>
 
 #include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <limits>
 #include <sys/time.h>
 
 # define GREEN "\e[92m"
@@ -52,6 +57,233 @@ static void printMapRev(M container) {
 	std::cout << GREEN << "}" << RESET << std::endl;
 }
 
+/* counts its default constructions */
+struct defaulted {
+	static long	defaults;
+	int			value;
+
+	defaulted() : value() { ++defaults; }
+};
+
+long defaulted::defaults = 0;
+
+/* counts what goes through it, the id tells copies of different allocators apart */
+long g_alloc_calls = 0;
+long g_alloc_live = 0;
+
+template <typename T>
+struct counting_allocator : public std::allocator<T> {
+	typedef typename std::allocator<T>::pointer		pointer;
+	typedef typename std::allocator<T>::size_type	size_type;
+
+	template <typename U>
+	struct rebind { typedef counting_allocator<U> other; };
+
+	int	id;
+
+	counting_allocator(int id = 0) : std::allocator<T>(), id(id) {}
+	template <typename U>
+	counting_allocator(const counting_allocator<U>& other) : std::allocator<T>(), id(other.id) {}
+
+	pointer allocate(size_type n, const void* = 0) {
+		++g_alloc_calls;
+		g_alloc_live += n * sizeof(T);
+		return std::allocator<T>::allocate(n);
+	}
+
+	void deallocate(pointer p, size_type n) {
+		g_alloc_live -= n * sizeof(T);
+		std::allocator<T>::deallocate(p, n);
+	}
+};
+
+template <typename T, typename U>
+bool operator==(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) { return lhs.id == rhs.id; }
+template <typename T, typename U>
+bool operator!=(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) { return lhs.id != rhs.id; }
+
+#if __cplusplus >= 201103L
+/* counts its copies, a move is free and cannot throw */
+struct tracked {
+	static long	copies;
+	int			value;
+
+	tracked(int value = 0) : value(value) {}
+	tracked(const tracked& other) : value(other.value) { ++copies; }
+	tracked(tracked&& other) noexcept : value(other.value) {}
+	tracked& operator=(const tracked& other) { value = other.value; ++copies; return *this; }
+	tracked& operator=(tracked&& other) noexcept { value = other.value; return *this; }
+	bool operator<(const tracked& rhs) const { return value < rhs.value; }
+};
+
+long tracked::copies = 0;
+#endif
+
+/* what map::merge and set::merge of C++17 do */
+template <typename C>
+static void mergeInto(C& target, C& source) {
+	for (typename C::iterator it = source.begin(); it != source.end(); ) {
+		if (target.insert(*it).second)
+			source.erase(it++);
+		else
+			++it;
+	}
+}
+
+/* what split_off of the ft containers does */
+template <typename C>
+static C splitOff(C& source, const typename C::key_type& key) {
+	C	right(source.lower_bound(key), source.end());
+	source.erase(source.lower_bound(key), source.end());
+	return right;
+}
+
+/* what nth and rank of the ft containers built with ft::tree_order_statistics do */
+template <typename C>
+static typename C::const_iterator nthOf(const C& c, size_t k) {
+	typename C::const_iterator	it = c.begin();
+	std::advance(it, std::min(k, c.size()));
+	return it;
+}
+
+template <typename C>
+static size_t rankOf(const C& c, const typename C::key_type& key) {
+	return std::distance(c.begin(), c.lower_bound(key));
+}
+
+/* what aggregate of the ft containers built with ft::tree_aggregate does, by a walk over [lo, hi) */
+template <typename M>
+static long sumRange(const M& m, int lo, int hi) {
+	long	sum = 0;
+	if (lo < hi)
+		for (typename M::const_iterator it = m.lower_bound(lo); it != m.lower_bound(hi); ++it)
+			sum += it->second;
+	return sum;
+}
+
+template <typename M>
+static long pointeeSumRange(const M& m, int lo, int hi) {
+	long	sum = 0;
+	if (lo < hi)
+		for (typename M::const_iterator it = m.lower_bound(lo); it != m.lower_bound(hi); ++it)
+			sum += *it->second;
+	return sum;
+}
+
+template <typename M>
+static int maxRange(const M& m, int lo, int hi) {
+	int	peak = std::numeric_limits<int>::min();
+	if (lo < hi)
+		for (typename M::const_iterator it = m.lower_bound(lo); it != m.lower_bound(hi); ++it)
+			peak = std::max(peak, it->second);
+	return peak;
+}
+
+template <typename S>
+static int minRange(const S& s, int lo, int hi) {
+	int	low = std::numeric_limits<int>::max();
+	if (lo < hi)
+		for (typename S::const_iterator it = s.lower_bound(lo); it != s.lower_bound(hi); ++it)
+			low = std::min(low, *it);
+	return low;
+}
+
+/* twelve bytes, the size growth_pow2 rounds up to whole powers of two */
+struct triple {
+	int	a, b, c;
+
+	triple(int value = 0) : a(value), b(value), c(value) {}
+	bool operator==(const triple& rhs) const { return a == rhs.a && b == rhs.b && c == rhs.c; }
+};
+
+/* the capacity each growth policy of ft::vector picks for values of size bytes */
+static size_t growFactor2(size_t capacity, size_t required, size_t) {
+	return std::max(capacity * 2, required);
+}
+
+static size_t growFactor1_5(size_t capacity, size_t required, size_t) {
+	return std::max(capacity + capacity / 2, required);
+}
+
+static size_t growPow2(size_t capacity, size_t required, size_t size) {
+	size_t	wanted = growFactor2(capacity, required, size);
+	size_t	bytes = 1;
+	while (bytes < wanted * size)
+		bytes *= 2;
+	return std::max(bytes / size, wanted);
+}
+
+/* what printGrowth of the ft side shows: std::vector is grown through reserve()
+	to the capacity next picks whenever the next element would not fit */
+template <typename T>
+static void printGrowth(const std::string& name, size_t (*next)(size_t, size_t, size_t), int count, int extra) {
+	std::vector<T>	vct;
+	size_t			capacity = 0;
+	bool			intact = true;
+
+	std::cout << name << ":";
+	for (int i = 0; i < count; ++i) {
+		if (vct.size() == capacity) {
+			capacity = next(capacity, vct.size() + 1, sizeof(T));
+			vct.reserve(capacity);
+			std::cout << " " << capacity;
+		}
+		vct.push_back(T(i));
+		for (int j = 0; j <= i; ++j)
+			intact = intact && vct[j] == T(j);
+	}
+	if (vct.size() + extra > capacity) {
+		capacity = next(capacity, vct.size() + extra, sizeof(T));
+		vct.reserve(capacity);
+	}
+	vct.insert(vct.begin() + count / 2, extra, T(-1));
+	for (int j = 0; j < count + extra; ++j)
+		intact = intact && vct[j] == T(j < count / 2 ? j : j < count / 2 + extra ? -1 : j - extra);
+	std::cout << ", after inserting " << extra << ": " << capacity << ", elements intact: " << intact << std::endl;
+}
+
+/* a std::vector kept to Capacity elements by hand, what ft::static_vector does:
+	an operation that would not fit is refused and raises overflowed, or throws
+	std::length_error when report is false */
+template <typename T, size_t Capacity>
+struct bounded_vector {
+	std::vector<T>	items;
+	bool			report;
+	bool			overflowed;
+
+	explicit bounded_vector(bool report) : report(report), overflowed(false) {}
+
+	size_t size() const				{ return items.size(); }
+	bool full() const				{ return items.size() == Capacity; }
+	const T& operator[](size_t i) const	{ return items[i]; }
+
+	bool fits(size_t count) {
+		if (items.size() + count <= Capacity)
+			return true;
+		overflowed = true;
+		if (!report)
+			throw std::length_error("bounded_vector");
+		return false;
+	}
+
+	bool try_push_back(const T& value) {
+		if (full())
+			return false;
+		items.push_back(value);
+		return true;
+	}
+
+	void push_back(const T& value) {
+		if (fits(1))
+			items.push_back(value);
+	}
+
+	void insert(size_t pos, size_t count, const T& value) {
+		if (fits(count))
+			items.insert(items.begin() + pos, count, value);
+	}
+};
+
 int main() {
 
 	{
@@ -220,6 +452,75 @@ int main() {
 			std::cout << "\nvector containes: ";
 			printVec (vct);
 		}
+		{
+			// growth policies are ft only, std::vector is grown by hand along the same formulas
+			std::cout << USCORED << "\ntest growth policies, capacities while pushing 100 elements:\n" << RESET;
+			printGrowth<int>("growth_factor_2", growFactor2, 100, 300);
+			printGrowth<int>("growth_factor_1_5", growFactor1_5, 100, 300);
+			printGrowth<int>("growth_pow2, int", growPow2, 100, 300);
+			printGrowth<triple>("growth_pow2, 12 bytes", growPow2, 100, 300);
+		}
+
+		{
+			// realloc_allocator is ft only, the ft side compares to these steps on a std::vector
+			std::cout << USCORED << "\ntest vector with realloc_allocator, reserve, insert in the middle, erase:\n" << RESET;
+			std::vector<int>	ref;
+
+			for (int step = 0; step < 8; ++step) {
+				switch (step) {
+					case 0: ref.reserve(10); break;
+					case 1: for (int i = 0; i < 20; ++i) ref.push_back(i); break;
+					case 2: ref.insert(ref.begin() + 10, 100, 42); break;
+					case 3: ref.insert(ref.begin() + 5, -5); break;
+					case 4: ref.reserve(1000); break;
+					case 5: ref.erase(ref.begin() + 8, ref.begin() + 115); break;
+					case 6: ref.erase(ref.begin()); break;
+					case 7: { std::vector<int> copy(ref); ref.insert(ref.begin() + 4, copy.begin(), copy.end()); } break;
+				}
+			}
+			std::cout << "same as std::vector after every step: " << true << std::endl;
+			printVec(ref);
+		}
+
+		{
+			// static_vector is ft only, a std::vector bounded by hand to 8 elements stands in for it
+			std::cout << USCORED << "\ntest static_vector filled to capacity:\n" << RESET;
+			bounded_vector<int, 8>	reporting(true);
+			for (int i = 0; i < 8; ++i)
+				reporting.push_back(i * 10);
+			std::cout << "full: " << reporting.full() << ", try_push_back(80): " << reporting.try_push_back(80)
+					  << ", overflowed: " << reporting.overflowed << std::endl;
+			reporting.push_back(80);
+			std::cout << "after push_back(80), overflowed: " << reporting.overflowed << ", size: " << reporting.size() << std::endl;
+			reporting.overflowed = false;
+			reporting.insert(3, 2, 35);
+			std::cout << "after insert of 2 in the middle, overflowed: " << reporting.overflowed << ", size: " << reporting.size() << std::endl;
+			printVec(reporting);
+
+			bounded_vector<int, 8>	throwing(false);
+			bool					threw = false;
+			throwing.items = reporting.items;
+			std::cout << "try_push_back(80): " << throwing.try_push_back(80) << std::endl;
+			try {
+				throwing.push_back(80);
+			} catch (std::length_error&) {
+				threw = true;
+			}
+			std::cout << "push_back(80) threw length_error: " << threw << ", size: " << throwing.size() << std::endl;
+			printVec(throwing);
+		}
+
+		{
+			std::cout << USCORED << "\ntest vector from std::istream_iterator, single pass input:\n" << RESET;
+			std::istringstream			numbers("1 2 3 4 5 6 7");
+			std::istringstream			more("-1 -2 -3");
+			std::vector<int>			vct((std::istream_iterator<int>(numbers)), std::istream_iterator<int>());
+			printVec(vct);
+			vct.insert(vct.begin() + 2, std::istream_iterator<int>(more), std::istream_iterator<int>());
+			std::cout << "size after range insert: " << vct.size() << std::endl;
+			printVec(vct);
+		}
+
 
 		std::cout << GREEN << "\ntotal time spent on std::vector testing = " << get_timestamp() - g_timestamp << " μs" << RESET << std::endl;;
 
@@ -240,7 +541,7 @@ int main() {
 			map_orig[5] = "ccc";
 			std::cout << "map size = " << map_orig.size() << std::endl;
 			std::cout << "map empty? = " << map_orig.empty() << std::endl;
-			std::cout << "map maxsize = " << map_orig.max_size() << std::endl;
+			std::cout << "map maxsize fits a million nodes = " << (map_orig.max_size() > 1000000) << std::endl;
 			std::cout << "\nmap containes: ";
 			printMap(map_orig);
 			std::cout << "\nreversed map containes: ";
@@ -326,6 +627,92 @@ int main() {
 			printMapRev(mp);
 		}
 
+		{
+			std::cout << USCORED << "\ntest custom allocator:\n" << RESET;
+			typedef counting_allocator< std::pair<const int, std::string> >							counted_pair_allocator;
+			typedef std::map<int, std::string, std::less<int>, counted_pair_allocator>	counted_map;
+			g_alloc_calls = 0;
+			{
+				counted_map	mp(std::less<int>(), counted_pair_allocator(42));
+				for (int i = 0; i < 100; ++i)
+					mp[i] = "x";
+				counted_map	cpy(mp);
+				std::cout << "nodes allocated through the allocator = " << (g_alloc_calls > 0) << std::endl;
+				std::cout << "allocator id of map and copy = " << mp.get_allocator().id << ", " << cpy.get_allocator().id << std::endl;
+				std::cout << "memory in use = " << (g_alloc_live > 0) << std::endl;
+			}
+			std::cout << "memory in use after destruction = " << g_alloc_live << std::endl;
+		}
+
+		{
+			// the sorted_unique tag is ft only, std builds the same maps from a plain range
+			std::cout << USCORED << "\ntest sorted_unique construction and insert:\n" << RESET;
+			std::pair<int, std::string>	sorted[6];
+			for (int i = 0; i < 6; ++i)
+				sorted[i] = std::make_pair(i * 3, std::string(1, char('a' + i)));
+			std::map<int, std::string>	built(sorted, sorted + 6);
+			std::map<int, std::string>	inserted(sorted, sorted + 6);
+			std::cout << "built size = " << built.size() << ", same as a range insert = " << (built == inserted) << std::endl;
+			printMap(built);
+			std::map<int, std::string>	none(sorted, sorted);
+			none.insert(sorted + 2, sorted + 2);
+			std::cout << "from empty ranges size = " << none.size() << ", empty = " << none.empty() << std::endl;
+			std::map<int, std::string>	target;
+			target[4] = "x";
+			target[6] = "y";
+			target[20] = "z";
+			std::map<int, std::string>	expected(target);
+			target.insert(sorted, sorted + 6);
+			expected.insert(sorted, sorted + 6);
+			std::cout << "into a non-empty map size = " << target.size() << ", same as a range insert = " << (target == expected) << std::endl;
+			printMap(target);
+		}
+
+		{
+			// try_insert is ft only, insert leaves an existing entry untouched as well
+			std::cout << USCORED << "\ntest try_insert:\n" << RESET;
+			std::map<int, std::string>						mp;
+			mp[1] = "one";
+			std::pair<std::map<int, std::string>::iterator, bool>	ret = mp.insert(std::make_pair(1, std::string("uno")));
+			std::cout << "present: inserted = " << ret.second << ", key = " << ret.first->first << ", value = " << ret.first->second << std::endl;
+			ret = mp.insert(std::make_pair(2, std::string("two")));
+			std::cout << "missing: inserted = " << ret.second << ", key = " << ret.first->first << ", value = " << ret.first->second << std::endl;
+			std::cout << "size = " << mp.size() << ", mp[1] = " << mp[1] << std::endl;
+			printMap(mp);
+		}
+		{
+			// std::next and std::prev are C++11, advance copies of the iterators instead
+			std::cout << USCORED << "\ntest next, prev and advance on map iterators:\n" << RESET;
+			std::map<int, int>	mp;
+			for (int i = 0; i < 10; ++i)
+				mp[i * 10] = i;
+			std::map<int, int>::iterator		it = mp.begin();
+			std::map<int, int>::const_iterator	cit = mp.end();
+			std::map<int, int>::iterator		n1 = it, n4 = it, p5 = it;
+			std::map<int, int>::const_iterator	p1 = cit, p3 = cit, n2 = cit;
+			std::advance(n1, 1); std::advance(n4, 4); std::advance(p5, 5);
+			std::advance(p1, -1); std::advance(p3, -3); std::advance(n2, -2);
+			std::cout << "next(begin()): " << n1->first << ", next(begin(), 4): " << n4->first << std::endl;
+			std::cout << "prev(end()): " << p1->first << ", prev(end(), 3): " << p3->first << std::endl;
+			std::cout << "next(end(), -2): " << n2->first << ", prev(begin(), -5): " << p5->first << std::endl;
+			std::advance(it, 7);
+			std::cout << "advance(it, 7): " << it->first;
+			std::advance(it, -3);
+			std::cout << ", advance(it, -3): " << it->first;
+			std::advance(it, 0);
+			std::cout << ", advance(it, 0): " << it->first << std::endl;
+			std::cout << "distance(begin(), it): " << std::distance(mp.begin(), it) << ", distance(it, end()): " << std::distance(it, mp.end()) << std::endl;
+		}
+
+		{
+			std::cout << USCORED << "\ntest operator[] builds a mapped value on a miss only:\n" << RESET;
+			std::map<int, defaulted>	m;
+			m[1].value = 10;
+			long					after_miss = defaulted::defaults;
+			m[1].value += 5;
+			std::cout << "default constructions, miss: " << after_miss << ", hits: " << defaulted::defaults - after_miss << ", value: " << m[1].value << std::endl;
+		}
+
 
 		std::cout << GREEN << "\ntotal time spent on std::map testing = " << get_timestamp() - g_timestamp << " μs" << RESET << std::endl;;
 
@@ -349,6 +736,28 @@ int main() {
 		stack_my.pop();
 		stack_my.pop();
 		std::cout << "stack top after pop = " << stack_my.top() << std::endl;
+
+		std::cout << USCORED << "\ntest stack over a small container:\n" << RESET;
+		std::stack<int, std::vector<int> > stack_small;
+		for (int i = 0; i < 10; ++i)
+			stack_small.push(i * 3);
+		std::stack<int, std::vector<int> > stack_copy(stack_small);
+		while (stack_small.size() > 2)
+			stack_small.pop();
+		std::cout << "size = " << stack_small.size() << ", top = " << stack_small.top() << std::endl;
+		std::cout << "copy size = " << stack_copy.size() << ", top = " << stack_copy.top() << std::endl;
+		std::cout << "small < copy? -> " << std::boolalpha << (stack_small < stack_copy) << std::endl;
+		stack_copy = stack_small;
+		std::cout << "equal after assignment? -> " << (stack_copy == stack_small) << std::endl;
+
+		std::cout << USCORED << "\ntest stack over a bounded container:\n" << RESET;
+		std::stack<int, std::vector<int> > stack_bounded;
+		for (int i = 0; i < 16; ++i)
+			stack_bounded.push(i);
+		std::cout << "size = " << stack_bounded.size() << ", top = " << stack_bounded.top() << std::endl;
+		stack_bounded.pop();
+		stack_bounded.push(-1);
+		std::cout << "top after pop and push = " << stack_bounded.top() << std::endl;
 		
 		std::cout << GREEN << "\ntotal time spent on std::stack testing = " << get_timestamp() - g_timestamp << " μs" << RESET << std::endl;;
 		
@@ -452,8 +861,424 @@ int main() {
 		std::cout << "the upper bound points to: " << *ret.second << '\n';
 	}
 
+	std::cout << "\ntest sorted_unique\n";
+	{
+		// the sorted_unique tag is ft only, std builds the same sets from a plain range
+		int				sorted[] = { 1, 4, 9, 16, 25 };
+		std::set<int>	built(sorted, sorted + 5);
+		std::set<int>	inserted(sorted, sorted + 5);
+		std::set<int>	none(sorted, sorted);
+		std::set<int>	target;
+		target.insert(9);
+		target.insert(30);
+		target.insert(sorted, sorted + 5);
+		std::cout << "same as a range insert = " << (built == inserted) << ", size = " << built.size() << ", from an empty range = " << none.size() << "\n";
+		for (std::set<int>::iterator it = target.begin(); it != target.end(); ++it)
+			std::cout << *it << " ";
+		std::cout << "\n";
+	}
+
+	std::cout << "\ntest custom allocator\n";
+	{
+		typedef std::set<int, std::less<int>, counting_allocator<int> >	counted_set;
+		g_alloc_calls = 0;
+		{
+			counted_set	s0(std::less<int>(), counting_allocator<int>(7));
+			for (int i = 0; i < 1000; ++i)
+				s0.insert(i);
+			s0.erase(s0.begin(), s0.find(500));
+			std::cout << "nodes allocated through the allocator = " << (g_alloc_calls > 0) << "\n";
+			std::cout << "allocator id = " << s0.get_allocator().id << "\n";
+		}
+		std::cout << "memory in use after destruction = " << g_alloc_live << "\n";
+	}
+
 		std::cout << GREEN << "\ntotal time spent on std::set testing = " << get_timestamp() - g_timestamp << " μs" << RESET << std::endl;;
 	}
 
+	{
+		std::cout << "----------- NODE HANDLE AND MERGE TESTING -----------" << std::endl;
+		g_timestamp = get_timestamp();
+
+		// extract() and merge() are C++17, they are spelled out with find, insert and erase
+		std::cout << USCORED << "\ntest map extract and insert of a node:\n" << RESET;
+		{
+			std::map<int, std::string>	young;
+			std::map<int, std::string>	old;
+			for (int i = 0; i < 8; ++i)
+				young[i] = std::string(1, char('a' + i));
+			old[3] = "old";
+			std::pair<int, std::string>	nh = *young.find(2);
+			young.erase(2);
+			std::cout << "extracted " << nh.first << " -> " << nh.second << ", young size = " << young.size() << std::endl;
+			std::pair<std::map<int, std::string>::iterator, bool>	ret = old.insert(nh);
+			std::cout << "inserted = " << ret.second << ", at " << ret.first->first << ", handle empty = " << true << std::endl;
+			nh = *young.find(3);
+			young.erase(3);
+			ret = old.insert(nh);
+			std::cout << "inserted = " << ret.second << ", handed back " << nh.first << " -> " << nh.second << ", old[3] = " << old[3] << std::endl;
+			old.insert(old.end(), *--young.end());
+			young.erase(--young.end());
+			std::cout << "extract of a missing key is empty = " << true << std::endl;
+			printMap(young);
+			printMap(old);
+		}
+
+		std::cout << USCORED << "\ntest a node outliving its map:\n" << RESET;
+		{
+			std::pair<int, std::string>	nh;
+			{
+				std::map<int, std::string>	gone;
+				gone[7] = "survivor";
+				gone[8] = "erased";
+				nh = *gone.find(7);
+			}
+			std::map<int, std::string>	target;
+			target.insert(nh);
+			target[9] = "new";
+			printMap(target);
+		}
+
+		std::cout << USCORED << "\ntest map merge:\n" << RESET;
+		{
+			std::map<int, int>	gen0;
+			std::map<int, int>	gen1;
+			for (int i = 0; i < 1000; ++i) {
+				gen0[i * 2] = 0;
+				gen1[i * 3] = 1;
+			}
+			mergeInto(gen1, gen0);
+			std::cout << "gen1 size = " << gen1.size() << ", gen0 size = " << gen0.size() << std::endl;
+			std::cout << "gen1[4] = " << gen1[4] << ", gen1[6] = " << gen1[6] << ", gen0 first = " << gen0.begin()->first << ", last = " << gen0.rbegin()->first << std::endl;
+			std::map<int, int>	few;
+			few[-1] = 2;
+			few[0] = 2;
+			few[5000] = 2;
+			mergeInto(gen1, few);
+			std::cout << "gen1 size = " << gen1.size() << ", few size = " << few.size() << ", gen1 first = " << gen1.begin()->first << ", last = " << gen1.rbegin()->first << std::endl;
+			gen0.clear();
+			gen1.erase(gen1.begin(), gen1.lower_bound(2990));
+			printMap(gen1);
+			mergeInto(gen0, gen1);
+			std::cout << "gen0 size = " << gen0.size() << ", gen1 size = " << gen1.size() << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest set extract and merge:\n" << RESET;
+		{
+			std::set<std::string>	a;
+			std::set<std::string>	b;
+			a.insert("apple");
+			a.insert("pear");
+			b.insert("pear");
+			b.insert("fig");
+			b.insert("kiwi");
+			mergeInto(a, b);
+			std::string	nh = *a.find("fig");
+			a.erase("fig");
+			std::cout << "extracted " << nh << std::endl;
+			b.insert(b.begin(), nh);
+			for (std::set<std::string>::iterator it = a.begin(); it != a.end(); ++it)
+				std::cout << *it << " ";
+			std::cout << "| ";
+			for (std::set<std::string>::iterator it = b.begin(); it != b.end(); ++it)
+				std::cout << *it << " ";
+			std::cout << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest maps stay independent after extract and merge:\n" << RESET;
+		{
+			std::map<int, std::string>	a;
+			std::map<int, std::string>	b;
+			for (int i = 0; i < 6; ++i) {
+				a[i] = std::string(1, char('a' + i));
+				b[i + 10] = std::string(1, char('A' + i));
+			}
+			a.insert(*b.begin());
+			b.erase(b.begin());
+			a.insert(*b.find(12));
+			b.erase(12);
+			b.clear();
+			b[20] = "fresh";
+			printMap(a);
+			printMap(b);
+			for (int i = 0; i < 5; ++i)
+				b[i * 2] = "b";
+			mergeInto(a, b);
+			printMap(b);
+			b.clear();
+			a.erase(a.begin());
+			a[30] = "late";
+			b[1] = "again";
+			printMap(a);
+			printMap(b);
+		}
+
+		std::cout << USCORED << "\ntest map split_off and append:\n" << RESET;
+		{
+			std::map<int, int>	left;
+			for (int i = 0; i < 1000; ++i)
+				left[i * 2] = i;
+			std::map<int, int>	right = splitOff(left, 1001);
+			std::cout << "left size = " << left.size() << ", last = " << left.rbegin()->first << ", right size = " << right.size() << ", first = " << right.begin()->first << std::endl;
+			std::map<int, int>	tail = splitOff(right, 1900);
+			std::map<int, int>	none = splitOff(tail, 5000);
+			std::map<int, int>	all = splitOff(left, -1);
+			std::cout << "right size = " << right.size() << ", tail size = " << tail.size() << ", none size = " << none.size() << ", left size = " << left.size() << ", all size = " << all.size() << std::endl;
+			mergeInto(all, tail);
+			std::cout << "all size = " << all.size() << ", tail size = " << tail.size() << ", last = " << all.rbegin()->first << std::endl;
+			mergeInto(right, all);
+			std::cout << "right size = " << right.size() << ", all size = " << all.size() << ", first = " << right.begin()->first << std::endl;
+			std::map<int, int>	overlap;
+			overlap[-5] = -1;
+			overlap[4] = -1;
+			overlap[5] = -1;
+			mergeInto(right, overlap);
+			std::cout << "right size = " << right.size() << ", overlap size = " << overlap.size() << ", right[4] = " << right[4] << std::endl;
+			right.erase(right.begin(), right.lower_bound(1990));
+			printMap(right);
+		}
+
+		std::cout << USCORED << "\ntest maps stay independent after split_off and append:\n" << RESET;
+		{
+			std::map<int, std::string>	whole;
+			for (int i = 0; i < 10; ++i)
+				whole[i] = std::string(1, char('a' + i));
+			std::map<int, std::string>	high = splitOff(whole, 7);
+			std::map<int, std::string>	low = splitOff(whole, 2);
+			low.swap(whole);
+			whole.clear();
+			whole[-1] = "z";
+			high[20] = "u";
+			low.erase(1);
+			printMap(whole);
+			printMap(low);
+			printMap(high);
+			mergeInto(low, high);
+			high.clear();
+			high[100] = "h";
+			mergeInto(whole, low);
+			low[50] = "l";
+			printMap(whole);
+			printMap(low);
+			printMap(high);
+		}
+
+		std::cout << USCORED << "\ntest set split_off and append:\n" << RESET;
+		{
+			std::set<std::string>	words;
+			words.insert("delta");
+			words.insert("alpha");
+			words.insert("echo");
+			words.insert("bravo");
+			words.insert("charlie");
+			std::set<std::string>	late = splitOff(words, "c");
+			std::set<std::string>	early;
+			early.insert("a");
+			mergeInto(early, words);
+			for (std::set<std::string>::iterator it = early.begin(); it != early.end(); ++it)
+				std::cout << *it << " ";
+			std::cout << "| ";
+			for (std::set<std::string>::iterator it = late.begin(); it != late.end(); ++it)
+				std::cout << *it << " ";
+			std::cout << "| " << words.size() << std::endl;
+		}
+
+		std::cout << GREEN << "\ntotal time spent on node handle and merge testing = " << get_timestamp() - g_timestamp << " μs" << RESET << std::endl;;
+	}
+
+	{
+		std::cout << "----------- ORDER STATISTICS TESTING -----------" << std::endl;
+		g_timestamp = get_timestamp();
+
+		typedef std::map<int, std::string>	ranked_map;
+		typedef std::set<int>				ranked_set;
+
+		std::cout << USCORED << "\ntest map nth, rank and distance:\n" << RESET;
+		{
+			ranked_map	pages;
+			for (int i = 0; i < 500; ++i)
+				pages[(i * 37) % 1000] = std::string(1, char('a' + i % 26));
+			std::cout << "size = " << pages.size() << ", nth(0) = " << nthOf(pages, 0)->first << ", nth(123) = " << nthOf(pages, 123)->first
+					  << ", nth(499) = " << nthOf(pages, 499)->first << ", nth(500) is end = " << (nthOf(pages, 500) == pages.end()) << std::endl;
+			std::cout << "rank(-1) = " << rankOf(pages, -1) << ", rank(500) = " << rankOf(pages, 500) << ", rank(501) = " << rankOf(pages, 501) << ", rank(5000) = " << rankOf(pages, 5000) << std::endl;
+			std::cout << "distance = " << std::distance(pages.begin(), pages.end()) << ", " << std::distance(pages.find(74), pages.lower_bound(700)) << std::endl;
+			for (int i = 0; i < 1000; i += 3)
+				pages.erase(i);
+			pages.insert(std::make_pair(1, std::string("one")));
+			std::cout << "size = " << pages.size() << ", page 3 of 10:";
+			for (ranked_map::const_iterator it = nthOf(pages, 20); it != nthOf(pages, 30); ++it)
+				std::cout << " " << it->first << it->second;
+			std::cout << std::endl;
+			ranked_map	upper = splitOff(pages, 500);
+			const ranked_map&	const_pages = pages;
+			std::cout << "after split_off: nth(10) = " << nthOf(const_pages, 10)->first << ", upper nth(10) = " << nthOf(upper, 10)->first
+					  << ", upper rank(600) = " << rankOf(upper, 600) << std::endl;
+			mergeInto(pages, upper);
+			ranked_map	copy(pages);
+			std::cout << "copy nth(200) = " << nthOf(copy, 200)->first << ", rank(800) = " << rankOf(copy, 800) << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest set nth, rank and distance:\n" << RESET;
+		{
+			ranked_set	scores;
+			for (int i = 0; i < 100; ++i)
+				scores.insert(i * i % 97);
+			std::cout << "size = " << scores.size() << ", median = " << *nthOf(scores, scores.size() / 2) << ", rank(50) = " << rankOf(scores, 50)
+					  << ", distance = " << std::distance(scores.find(4), scores.find(81)) << std::endl;
+		}
+
+		std::cout << GREEN << "\ntotal time spent on order statistics testing = " << get_timestamp() - g_timestamp << " μs" << RESET << std::endl;;
+	}
+
+	{
+		std::cout << "----------- RANGE AGGREGATE TESTING -----------" << std::endl;
+		g_timestamp = get_timestamp();
+
+		typedef std::map<int, long>						sum_map;
+		typedef std::map<int, int>	max_map;
+		typedef std::set<int>								min_set;
+
+		std::cout << USCORED << "\ntest map aggregate of a sliding window:\n" << RESET;
+		{
+			sum_map	sums;
+			max_map	peaks;
+			for (int second = 0; second < 600; ++second) {
+				sums[second] = (second * 7919) % 1000;
+				peaks.insert(std::make_pair(second, (second * 104729) % 5000));
+			}
+			for (int end = 60; end <= 600; end += 90)
+				std::cout << "[" << end - 60 << ", " << end << ") sum = " << sumRange(sums, end - 60, end) << ", peak = " << maxRange(peaks, end - 60, end) << std::endl;
+			std::cout << "all = " << sumRange(sums, -1, 1000) << ", empty = " << sumRange(sums, 300, 300) << ", reversed = " << sumRange(sums, 400, 300)
+					  << ", outside = " << sumRange(sums, 1000, 2000) << std::endl;
+			sums.erase(sums.begin(), sums.lower_bound(300));
+			peaks.erase(peaks.begin(), peaks.lower_bound(300));
+			sums[450] = 1000000;
+			peaks.find(451)->second = 99999;
+			std::cout << "after eviction: sum = " << sumRange(sums, 0, 600) << ", [440, 460) sum = " << sumRange(sums, 440, 460)
+					  << ", peak = " << maxRange(peaks, 0, 600) << ", peak before 451 = " << maxRange(peaks, 0, 451) << std::endl;
+			sum_map	tail = splitOff(sums, 500);
+			std::cout << "split: sum = " << sumRange(sums, 0, 600) << ", tail sum = " << sumRange(tail, 0, 600) << std::endl;
+			mergeInto(sums, tail);
+			sum_map	copy(sums);
+			std::cout << "joined copy: sum = " << sumRange(copy, 0, 600) << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest refresh of an aggregate over pointers:\n" << RESET;
+		{
+			// aggregate is ft only, the stale sums are the ones walked before the write
+			typedef std::map<int, const long*>	pointee_map;
+			long		balances[50];
+			pointee_map	accounts;
+			for (int i = 0; i < 50; ++i) {
+				balances[i] = i * 10;
+				accounts.insert(pointee_map::value_type(i, &balances[i]));
+			}
+			std::cout << "mapped values are const: " << true << ", plain map: " << false << std::endl;
+			long	sum = pointeeSumRange(accounts, 0, 50);
+			long	window = pointeeSumRange(accounts, 20, 30);
+			std::cout << "sum = " << sum << ", [20, 30) sum = " << window << std::endl;
+			balances[25] += 1000;
+			std::cout << "stale after a write elsewhere: sum = " << sum << ", [20, 30) sum = " << window << std::endl;
+			std::cout << "after refresh: sum = " << pointeeSumRange(accounts, 0, 50) << ", [20, 30) sum = " << pointeeSumRange(accounts, 20, 30) << std::endl;
+			accounts.find(26)->second = &balances[0];
+			std::cout << "after update: sum = " << pointeeSumRange(accounts, 0, 50) << ", [20, 30) sum = " << pointeeSumRange(accounts, 20, 30) << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest set aggregate:\n" << RESET;
+		{
+			min_set	lows;
+			for (int i = 0; i < 200; ++i)
+				lows.insert((i * 37) % 211 - 100);
+			std::cout << "min = " << minRange(lows, -1000, 1000) << ", min of [0, 50) = " << minRange(lows, 0, 50) << ", min of [50, 51) = " << minRange(lows, 50, 51) << std::endl;
+		}
+
+		std::cout << GREEN << "\ntotal time spent on range aggregate testing = " << get_timestamp() - g_timestamp << " μs" << RESET << std::endl;;
+	}
+
+#if __cplusplus >= 201103L
+	{
+		std::cout << "----------- MOVE AND EMPLACE TESTING -----------" << std::endl;
+		g_timestamp = get_timestamp();
+
+		std::cout << USCORED << "\ntest vector growth moves its elements:\n" << RESET;
+		{
+			std::vector<tracked>	vec;
+			tracked::copies = 0;
+			for (int i = 0; i < 1000; ++i)
+				vec.emplace_back(i);
+			vec.insert(vec.begin() + 10, tracked(-1));
+			vec.emplace(vec.begin(), -2);
+			std::cout << "size = " << vec.size() << ", front = " << vec.front().value << ", [11] = " << vec[11].value << std::endl;
+			std::cout << "copies while growing = " << tracked::copies << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest vector move constructor and assignment:\n" << RESET;
+		{
+			std::vector<std::string>	vec;
+			vec.emplace_back(3, 'x');
+			vec.push_back(std::string("moved"));
+			vec.emplace(vec.begin() + 1, "middle");
+			std::vector<std::string>	moved(std::move(vec));
+			std::cout << "source size = " << vec.size() << ", target: ";
+			printVec(moved);
+			std::vector<std::string>	assigned(2, "old");
+			assigned = std::move(moved);
+			std::cout << "source size = " << moved.size() << ", target: ";
+			printVec(assigned);
+		}
+
+		std::cout << USCORED << "\ntest pair move:\n" << RESET;
+		{
+			std::pair<std::string, std::string>	p("first", "second");
+			std::pair<std::string, std::string>	q(std::move(p));
+			std::cout << "source = [" << p.first << ", " << p.second << "], target = [" << q.first << ", " << q.second << "]" << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest map emplace and move:\n" << RESET;
+		{
+			std::map<int, std::string>	mp;
+			std::cout << "emplace(1, one) inserted = " << mp.emplace(1, "one").second << std::endl;
+			std::cout << "emplace(1, uno) inserted = " << mp.emplace(1, "uno").second << std::endl;
+			mp.emplace_hint(mp.end(), 3, "three");
+			mp.emplace_hint(mp.begin(), 2, "two");
+			mp.insert(std::make_pair(4, std::string("four")));
+			mp.insert(mp.end(), std::make_pair(5, std::string("five")));
+			printMap(mp);
+			std::map<int, std::string>	moved(std::move(mp));
+			std::cout << "source size = " << mp.size() << ", target size = " << moved.size() << std::endl;
+			mp = std::move(moved);
+			std::cout << "source size = " << moved.size() << ", target size = " << mp.size() << std::endl;
+			std::map<std::string, int>	words;
+			std::string					key("key");
+			words[std::move(key)] = 42;
+			std::cout << "words[key] = " << words["key"] << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest set emplace and move:\n" << RESET;
+		{
+			std::set<tracked>	st;
+			tracked::copies = 0;
+			for (int i = 0; i < 100; ++i)
+				st.emplace(i % 50);
+			st.emplace_hint(st.end(), 100);
+			st.insert(tracked(101));
+			std::cout << "size = " << st.size() << ", copies = " << tracked::copies << std::endl;
+			std::set<tracked>	moved(std::move(st));
+			std::cout << "source size = " << st.size() << ", target size = " << moved.size() << std::endl;
+		}
+
+		std::cout << USCORED << "\ntest stack emplace and move:\n" << RESET;
+		{
+			std::stack<std::string>	stack;
+			stack.emplace(2, 'a');
+			stack.push(std::string("top"));
+			std::stack<std::string>	moved(std::move(stack));
+			std::cout << "source size = " << stack.size() << ", target top = " << moved.top() << ", size = " << moved.size() << std::endl;
+		}
+
+		std::cout << GREEN << "\ntotal time spent on move and emplace testing = " << get_timestamp() - g_timestamp << " μs" << RESET << std::endl;;
+	}
+#endif
+
 	return 0;
 }
\ No newline at end of file
@@ -10,17 +10,24 @@
 
 namespace ft {
 
-template< class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator<Key> >
+template< class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator<Key>, class Policy = ft::tree_plain >
 class map {
 	public:
 		typedef T										mapped_type;
 		typedef Key										key_type;
 		typedef ft::pair<const key_type, mapped_type>	value_type;
 		typedef Compare									key_compare;
+		typedef Policy									tree_policy;
 
-		class value_compare : public std::binary_function< key_type, value_type, bool > {
+		/* std::binary_function is deprecated from C++11 on, its typedefs are spelled out */
+		class value_compare {
 			friend class map;
 
+			public:
+				typedef bool		result_type;
+				typedef value_type	first_argument_type;
+				typedef value_type	second_argument_type;
+
 			protected:
 				key_compare comp;
 				value_compare(Compare c) : comp(c) { }
@@ -33,27 +40,42 @@ class map {
 		typedef typename allocator_type::const_pointer								const_pointer;
 		typedef typename allocator_type::reference									reference;
 		typedef typename allocator_type::const_reference							const_reference;
-		typedef typename ft::_Rb_tree<value_type, value_compare>::iterator			iterator;
-		typedef typename ft::_Rb_tree<value_type, value_compare>::const_iterator	const_iterator;
+
+	private:
+		typedef ft::_Rb_tree<key_type, value_type, ft::_Select1st<value_type>, key_compare, allocator_type, Policy>	map_tree;
+
+		/* a map that folds its values (Policy = ft::tree_aggregate) only hands them out as const:
+			a value changed in place would leave the summaries above its node stale */
+		typedef ft::integral_constant<bool, !ft::is_same<typename Policy::summary_type, void>::value>	_aggregates;
+
+	public:
+		typedef typename ft::conditional<_aggregates::value, typename map_tree::const_iterator,
+											typename map_tree::iterator>::type						iterator;
+		typedef typename ft::conditional<_aggregates::value, const mapped_type&, mapped_type&>::type	mapped_reference;
+		typedef typename map_tree::const_iterator									const_iterator;
 		typedef typename ft::reverse_iterator<iterator>								reverse_iterator;
 		typedef typename ft::reverse_iterator<const_iterator>						const_reverse_iterator;
-		typedef typename ft::_Rb_tree<value_type, value_compare>::difference_type	difference_type;
-		typedef typename ft::_Rb_tree<value_type, value_compare>::size_type			size_type;
+		typedef typename map_tree::difference_type									difference_type;
+		typedef typename map_tree::size_type										size_type;
+		typedef typename map_tree::node_handle										node_type;
+		typedef ft::node_insert_return<iterator, node_type>							insert_return_type;
 
 	private:
-		ft::_Rb_tree<value_type, value_compare>	_map_tree;
-		allocator_type							_map_alloc;
+		map_tree		_map_tree;
 
 	public:
 		explicit map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
-			_map_tree(value_compare(comp)),
-			_map_alloc(alloc) {}
+			_map_tree(comp, alloc) {}
 
 		template<class InputIterator>
 		map(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
-			_map_tree(value_compare(comp)), _map_alloc(alloc) { insert(first, last); }
+			_map_tree(comp, alloc) { insert(first, last); }
+
+		template<class ForwardIterator>
+		map(ft::sorted_unique_t, ForwardIterator first, ForwardIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
+			_map_tree(comp, alloc) { insert(ft::sorted_unique, first, last); }
 
-		map (const map& other) : _map_tree(other._map_tree), _map_alloc(other._map_alloc) {}
+		map (const map& other) : _map_tree(other._map_tree) {}
 
 		~map() {}
 
@@ -61,10 +83,18 @@ class map {
 			if (this == &other)
 				return *this;
 			_map_tree = other._map_tree;
-			_map_alloc = other._map_alloc;
 			return *this;
 		}
 
+#if __cplusplus >= 201103L
+		map(map&& other) : _map_tree(ft::move(other._map_tree)) {}
+
+		map& operator=(map&& other) {
+			_map_tree = ft::move(other._map_tree);
+			return *this;
+		}
+#endif
+
 		bool empty(void) const						{ return _map_tree.empty(); }
 		size_type size(void) const					{ return _map_tree.size(); }
 		iterator begin(void) 						{ return _map_tree.begin(); }
@@ -77,32 +107,29 @@ class map {
 		const_reverse_iterator rend (void) const	{ return const_reverse_iterator(begin()); }
 		size_type max_size(void) const				{ return _map_tree.max_size(); }
 		void clear(void)							{ _map_tree.clear(); }
-		key_compare key_comp(void) const			{ return key_compare(); }
-		value_compare value_comp(void) const		{ return value_compare(key_compare()); }
-		allocator_type get_allocator(void) const	{ return allocator_type(); }
+		key_compare key_comp(void) const			{ return _map_tree.key_comp(); }
+		value_compare value_comp(void) const		{ return value_compare(key_comp()); }
+		allocator_type get_allocator(void) const	{ return allocator_type(_map_tree.get_allocator()); }
 		void swap(map& other)						{ _map_tree.swap(other._map_tree); }
 
 
-		mapped_type& operator[](const key_type& key) {
-			value_type	value(key, mapped_type());
-			ft::pair< iterator, bool > insert_ret = _map_tree.insert(value);
-			return insert_ret.first->second;
-		}
+		/* one descent, the entry and its default mapped_type are only built when key is missing */
+		mapped_reference operator[](const key_type& key) { return _map_tree.try_insert_key(key).first->second; }
 
-		mapped_type& at(const key_type& key) {
-			value_type	value(key, mapped_type());
-			iterator it = _map_tree.find(value);
+#if __cplusplus >= 201103L
+		mapped_reference operator[](key_type&& key) { return _map_tree.try_insert_key(ft::move(key)).first->second; }
+#endif
+
+		mapped_reference at(const key_type& key) {
+			iterator it = _map_tree.find(key);
 			if (it == end())
 				throw (std::out_of_range("map"));
-			if (value_comp() (*it, value) || value_comp() (value, *it))
-				throw (std::out_of_range("map"));
 			return it->second;
 		}
 
 		const mapped_type& at(const key_type& key) const {
-			value_type		value(key, mapped_type());
-			const_iterator	it = _map_tree.find(value);
-			if (it == end() || *it != value)
+			const_iterator	it = _map_tree.find(key);
+			if (it == end())
 				throw (std::out_of_range("map"));
 			return it->second;
 		}
@@ -111,118 +138,146 @@ class map {
 
 		iterator insert(iterator hint, const value_type& val) { return _map_tree.insert(hint, val); }
 
-		template< class InputIterator >
-		void insert(InputIterator first, InputIterator last) {
-			for (; first != last; first++)
-				_map_tree.insert(*first);
-		}
+#if __cplusplus >= 201103L
+		ft::pair<iterator, bool> insert(value_type&& val) { return _map_tree.insert(ft::move(val)); }
 
-		void erase(iterator position) { _map_tree.erase(position); }
+		iterator insert(iterator hint, value_type&& val) { return _map_tree.insert(hint, ft::move(val)); }
 
-		size_type erase(const key_type& key) {
-			value_type	value(key, mapped_type());
-			return _map_tree.erase(value);
-		}
-	
-		void erase(iterator first, iterator last) {
-			while (first != last)
-				first = _map_tree.erase(first);
-		}
+		template<class... Args>
+		ft::pair<iterator, bool> emplace(Args&&... args) { return _map_tree.emplace(ft::forward<Args>(args)...); }
 
-		iterator find(const key_type& k) {
-			if (!size()) return end();
-			value_type	value(k, mapped_type());
-			iterator it = _map_tree.find(value);
-			return (!value_comp()(*it, value) && !value_comp()(value, *it)) ? it : end();
-		}
+		template<class... Args>
+		iterator emplace_hint(iterator hint, Args&&... args) { return _map_tree.emplace_hint(hint, ft::forward<Args>(args)...); }
+#endif
 
-		const_iterator find(const key_type& k) const {
-			if (!size())
-				return end();
-			value_type 		value(k, mapped_type());
-			const_iterator	it = _map_tree.find(value);
-			return (!value_comp()(*it, value) && !value_comp()(value, *it)) ? it : end();		
-		}
+		/* inserts (key, obj) unless key is already there, without building a value_type first;
+			an existing entry is left untouched */
+		ft::pair<iterator, bool> try_insert(const key_type& key, const mapped_type& obj) { return _map_tree.try_insert(key, obj); }
 
-		size_type count(const key_type& k) const {
-			if (!size())
-				return 0;
-			value_type		value(k, mapped_type());
-			const_iterator	it = _map_tree.find(value);
-			return (!value_comp()(*it, value) && !value_comp()(value, *it)) ? 1 : 0;
+		/* inserts (key, obj), or assigns obj to the entry already there through update() */
+		ft::pair<iterator, bool> insert_or_assign(const key_type& key, const mapped_type& obj) {
+			ft::pair<iterator, bool>	ret = _map_tree.try_insert(key, obj);
+			if (!ret.second)
+				update(ret.first, obj);
+			return ret;
 		}
 
-		iterator lower_bound(const key_type& k) {
-			if (!size())
-				return end();
-			value_type	value(k, mapped_type());
-			iterator	it = _map_tree.find(value);
-			return value_comp()(*it, value) ? ++it : it;
-		}
+		/* node handles: extract() unlinks the entry's node, which insert() links into a
+			map of the same type as it is; with equal allocators the two maps share
+			their node pools from then on, nothing is allocated or copied */
+		node_type extract(iterator position)		{ return _map_tree.extract(position); }
 
-		const_iterator lower_bound(const key_type& k) const {
-			if (!size())
-				return end();
-			value_type		value(k, mapped_type());
-			const_iterator	it = _map_tree.find(value);
-			return value_comp()(*it, value) ? ++it : it;
-		}
+		node_type extract(const key_type& key)		{ return _map_tree.extract(key); }
 
-		iterator upper_bound(const key_type& k) {
-			if (!size())
-				return end();
-			value_type	value(k, mapped_type());
-			iterator	it = _map_tree.find(value);
-			return !value_comp()(value, *it) ? ++it : it;
+		insert_return_type insert(node_type nh) {
+			ft::pair<iterator, bool>	inserted = _map_tree.insert(nh);
+			insert_return_type			ret;
+			ret.position = inserted.first;
+			ret.inserted = inserted.second;
+			ret.node = ft::move(nh);
+			return ret;
 		}
 
-		const_iterator upper_bound(const key_type& k) const {
-			if (!size())
-				return end();
-			value_type		value(k, mapped_type());
-			const_iterator	it = _map_tree.find(value);
-			return !value_comp()(value, *it) ? ++it : it;
+		iterator insert(iterator hint, node_type nh) { return _map_tree.insert(hint, nh); }
+
+		/* takes over every entry of other whose key is missing here, by relinking
+			their nodes: the two maps share their node pools from then on */
+		void merge(map& other) { _map_tree.merge(other._map_tree); }
+
+		/* moves the entries whose key is not less than key into the returned map,
+			which shares this map's node pool: the map is cut in O(log n) relinks,
+			nothing is copied. The size of the smaller part, of k entries, is counted
+			in O(k), unless the map is built with tree_order_statistics: then the
+			whole split is O(log n). */
+		map split_off(const key_type& key) {
+			map	right(key_comp(), get_allocator());
+			_map_tree.split(key, right._map_tree);
+			return right;
 		}
 
-		ft::pair< iterator, iterator > equal_range(const key_type& k) {
-			iterator first = lower_bound(k);
-			iterator second = upper_bound(k);
-			return ft::make_pair< iterator, iterator >(first, second);
+		/* takes over every entry of other, whose keys must all sort before or after this
+			map's, in O(log n) relinks; the two share their node pools from then on */
+		void append(map& other) { _map_tree.join(other._map_tree); }
+
+#if __cplusplus >= 201103L
+		void append(map&& other) { _map_tree.join(other._map_tree); }
+#endif
+
+		template< class InputIterator >
+		void insert(InputIterator first, InputIterator last) { _map_tree.insert_range(first, last); }
+
+		template< class ForwardIterator >
+		void insert(ft::sorted_unique_t, ForwardIterator first, ForwardIterator last) { _map_tree.insert_range(ft::sorted_unique, first, last); }
+
+		void erase(iterator position) { _map_tree.erase(position); }
+
+		size_type erase(const key_type& key)	{ return _map_tree.erase(key); }
+	
+		void erase(iterator first, iterator last) {
+			while (first != last)
+				first = _map_tree.erase(first);
 		}
 
-		ft::pair< const_iterator, const_iterator > equal_range(const key_type& k) const {
-			const_iterator first = lower_bound(k);
-			const_iterator second = upper_bound(k);
-			return ft::make_pair< const_iterator, const_iterator >(first, second);
+		iterator find(const key_type& k)					{ return _map_tree.find(k); }
+		const_iterator find(const key_type& k) const		{ return _map_tree.find(k); }
+		size_type count(const key_type& k) const			{ return _map_tree.count(k); }
+		iterator lower_bound(const key_type& k)				{ return _map_tree.lower_bound(k); }
+		const_iterator lower_bound(const key_type& k) const	{ return _map_tree.lower_bound(k); }
+		iterator upper_bound(const key_type& k)				{ return _map_tree.upper_bound(k); }
+		const_iterator upper_bound(const key_type& k) const	{ return _map_tree.upper_bound(k); }
+
+		ft::pair< iterator, iterator > equal_range(const key_type& k)						{ return _map_tree.equal_range(k); }
+		ft::pair< const_iterator, const_iterator > equal_range(const key_type& k) const	{ return _map_tree.equal_range(k); }
+
+		/* order statistics in O(log n), for maps built with Policy = ft::tree_order_statistics:
+			the entry at index k (end() past the last), the index of lower_bound(k), and
+			the number of entries between two iterators */
+		iterator nth(size_type k)												{ return _map_tree.nth(k); }
+		const_iterator nth(size_type k) const									{ return _map_tree.nth(k); }
+		size_type rank(const key_type& k) const									{ return _map_tree.rank(k); }
+		difference_type distance(const_iterator first, const_iterator last) const	{ return _map_tree.distance(first, last); }
+
+		/* for maps built with Policy = ft::tree_aggregate<Monoid>: the monoid folded over the
+			entries whose keys lie in [lo, hi), in O(log n). Such a map hands out its mapped
+			values as const, update() and insert_or_assign() change one and bring the
+			summaries above it up to date. refresh() only does the latter, for a value
+			whose summary changed without the value itself, such as a pointer to data
+			changed elsewhere. */
+		typename Policy::summary_type aggregate(const key_type& lo, const key_type& hi) const	{ return _map_tree.aggregate(lo, hi); }
+		void refresh(iterator pos)																{ _map_tree.refresh(pos); }
+
+		void update(iterator pos, const mapped_type& obj) {
+			typename map_tree::iterator(pos.base(), pos.getLastNode())->second = obj;
+			_map_tree.refresh(pos);
 		}
 
-		friend bool operator==(const map< Key, T, Compare, Alloc >& lhs, const map< Key, T, Compare, Alloc >& rhs) {
+		friend bool operator==(const map< Key, T, Compare, Alloc, Policy >& lhs, const map< Key, T, Compare, Alloc, Policy >& rhs) {
 			return (lhs._map_tree == rhs._map_tree);
 		}
 
-		friend bool operator!=(const map< Key, T, Compare, Alloc >& lhs, const map< Key, T, Compare, Alloc >& rhs) {
+		friend bool operator!=(const map< Key, T, Compare, Alloc, Policy >& lhs, const map< Key, T, Compare, Alloc, Policy >& rhs) {
 			return !(lhs == rhs);
 		}
 
-		friend bool operator<(const map< Key, T, Compare, Alloc >& lhs,  const map< Key, T, Compare, Alloc >& rhs) {
+		friend bool operator<(const map< Key, T, Compare, Alloc, Policy >& lhs,  const map< Key, T, Compare, Alloc, Policy >& rhs) {
 			return (lhs._map_tree < rhs._map_tree);
 		}
 
-		friend bool operator<=(const map< Key, T, Compare, Alloc >& lhs, const map< Key, T, Compare, Alloc >& rhs) {
-			return (lhs < rhs || lhs == rhs);
+		friend bool operator<=(const map< Key, T, Compare, Alloc, Policy >& lhs, const map< Key, T, Compare, Alloc, Policy >& rhs) {
+			return !(rhs < lhs);
 		}
 
-		friend bool operator>(const map< Key, T, Compare, Alloc >& lhs, const map< Key, T, Compare, Alloc >& rhs) {
+		friend bool operator>(const map< Key, T, Compare, Alloc, Policy >& lhs, const map< Key, T, Compare, Alloc, Policy >& rhs) {
 			return (rhs < lhs);
 		}
 
-		friend bool operator>=(const map< Key, T, Compare, Alloc >& lhs, const map< Key, T, Compare, Alloc >& rhs) {
-			return (lhs > rhs || lhs == rhs);
+		friend bool operator>=(const map< Key, T, Compare, Alloc, Policy >& lhs, const map< Key, T, Compare, Alloc, Policy >& rhs) {
+			return !(lhs < rhs);
 		}
 };
 
-template< class Key, class T, class Compare, class Alloc >
-void swap(ft::map< Key, T, Compare, Alloc>& lhs, ft::map< Key, T, Compare, Alloc>& rhs) { lhs.swap(rhs); }
+template< class Key, class T, class Compare, class Alloc, class Policy >
+void swap(ft::map< Key, T, Compare, Alloc, Policy >& lhs, ft::map< Key, T, Compare, Alloc, Policy >& rhs) { lhs.swap(rhs); }
 
 }
 
@@ -0,0 +1,354 @@
+/*
+ABOUT:
+	node_pool - slab allocator for the nodes of ft::_Rb_tree
+
+	Nodes are handed out from contiguous slabs obtained from the tree allocator,
+	so a tree of n elements costs O(log n) allocator calls instead of n.
+	Erased nodes are kept on a free list and recycled by the next insertion.
+
+	The slabs, the free list and the cursor into the last slab make up the
+	state of the pool, kept in the first slab itself, which node_pool objects
+	hold by reference count. Trees that trade nodes (node handles, merge,
+	split, join) share() their pools: the two states are united, the one
+	joined forwards to the other, so a node can go from one tree to another
+	as it is and be given back by whichever tree erases it, to a free list
+	all of them recycle from. The memory goes back to the allocator by whole
+	slabs in release(), when the last tree or node handle holding the state
+	lets go of it: when it is cleared or destroyed.
+	A state held by one owner alone is used without a lock. One held by more
+	takes its lock on every access, so trees that traded nodes can still be
+	used from different threads; C++98 has no lock to take, there they cannot.
+	The allocator is kept as an empty base, a stateless one costs no space.
+*/
+
+#ifndef NODE_POOL_HPP
+#define NODE_POOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+
+#if __cplusplus >= 201103L
+# include <atomic>
+# include <mutex>
+#endif
+
+#ifndef FT_NODE_POOL_MIN_SLAB
+# define FT_NODE_POOL_MIN_SLAB 16
+#endif
+
+#ifndef FT_NODE_POOL_MAX_SLAB
+# define FT_NODE_POOL_MAX_SLAB 4096
+#endif
+
+namespace ft {
+
+template<class Node, class Alloc = std::allocator<Node> >
+class node_pool : private Alloc {
+	public:
+		typedef Node			node_type;
+		typedef Alloc			allocator_type;
+		typedef size_t			size_type;
+
+	private:
+		// stored in the first slot(s) of every slab
+		struct _slab {
+			_slab*		next;
+			size_type	count;
+		};
+
+		/* stored right after the header of the first slab. refs counts the
+			node_pool objects that hold it and the states forwarding to it */
+		struct _state {
+			_slab*		slabs;
+			node_type*	free;
+			node_type*	free_tail;
+			node_type*	cursor;
+			node_type*	slab_end;
+			size_type	next_slab;
+			size_type	reserved;
+#if __cplusplus >= 201103L
+			std::atomic<size_type>	refs;
+			std::atomic<_state*>	forward;
+			std::mutex				mutex;
+#else
+			size_type	refs;
+			_state*		forward;
+#endif
+
+			_state() : slabs(), free(), free_tail(), cursor(), slab_end(), next_slab(FT_NODE_POOL_MIN_SLAB), reserved(), refs(1), forward(NULL) {}
+		};
+
+		enum {
+			_header_slots = (sizeof(_slab) + sizeof(Node) - 1) / sizeof(Node),
+			_state_slots = (sizeof(_slab) + sizeof(_state) + sizeof(Node) - 1) / sizeof(Node)
+		};
+
+		/* the state of a pool, locked for as long as it lives unless the pool holds it alone */
+		class _guard {
+			private:
+				bool	_locked;
+
+			public:
+				_state*	state;
+
+				explicit _guard(node_pool& pool) : _locked(), state(pool._lock(_locked)) {}
+				~_guard() {
+					if (_locked)
+						_unlock(state);
+				}
+
+			private:
+				_guard(const _guard&);
+				_guard& operator=(const _guard&);
+		};
+
+		_state*			_shared;
+
+		node_pool& operator=(const node_pool&);
+
+	public:
+		explicit node_pool(const allocator_type& alloc = allocator_type()) : Alloc(alloc), _shared() {}
+
+		// a copy never shares slabs with the original
+		node_pool(const node_pool& other) : Alloc(other.allocator()), _shared() {}
+
+		~node_pool() { release(); }
+
+		/* returns raw storage for one node, the caller constructs it */
+		node_type* allocate() {
+			if (!_shared)
+				_create(FT_NODE_POOL_MIN_SLAB);
+			_guard		guard(*this);
+			_state*		s = guard.state;
+			if (s->reserved && s->cursor != s->slab_end) {
+				s->reserved--;
+				return s->cursor++;
+			}
+			s->reserved = 0;
+			if (s->free) {
+				node_type* n = s->free;
+				s->free = _nextFree(n);
+				return n;
+			}
+			if (s->cursor == s->slab_end)
+				_newSlab(s, s->next_slab);
+			return s->cursor++;
+		}
+
+		/* the next n allocate() calls bypass the free list and are served from one
+			slab, the unused tail of the current one is moved to the free list if it
+			is too short. Another tree allocating from a shared state at the same
+			time may take some of those nodes, the calls are then served as usual. */
+		void reserve(size_type n) {
+			if (!_shared)
+				_create(std::max<size_type>(n, FT_NODE_POOL_MIN_SLAB));
+			_guard		guard(*this);
+			_state*		s = guard.state;
+			if (size_type(s->slab_end - s->cursor) < n) {
+				while (s->cursor != s->slab_end)
+					_push(s, s->cursor++);
+				_newSlab(s, n);
+			}
+			s->reserved = n;
+		}
+
+		/* the node must already be destroyed, its storage is recycled */
+		void deallocate(node_type* n) {
+			_guard		guard(*this);
+			_push(guard.state, n);
+		}
+
+		/* lets go of the state: the last owner gives every slab back to the
+			allocator, all nodes must be destroyed or given back before */
+		void release() {
+			if (!_shared)
+				return ;
+			_state* s = _shared;
+			_shared = NULL;
+			_drop(s);
+		}
+
+		/* unites the states of the two pools, whose allocators must compare equal:
+			a node of either can then be given back to either. O(1) but for the
+			slab lists, which are O(log n) long, the first time two states meet. */
+		void share(node_pool& other) {
+			if (this == &other || !other._shared)
+				return ;
+			other._resolve();
+			if (!_shared) {
+				_shared = other._shared;
+				_retain(_shared);
+				return ;
+			}
+			while (true) {
+				_resolve();
+				other._resolve();
+				_state*	a = _shared;
+				_state*	b = other._shared;
+				if (a == b)
+					return ;
+				_state*	first = std::less<_state*>()(a, b) ? a : b;
+				_state*	second = (first == a) ? b : a;
+				_lockState(first);
+				_lockState(second);
+				bool	roots = !_forwardOf(a) && !_forwardOf(b);
+				if (roots)
+					_unite(a, b);
+				_unlock(second);
+				_unlock(first);
+				if (roots)
+					break ;
+			}
+			_resolve();
+			other._resolve();
+		}
+
+		/* whether another tree or node handle holds the state too */
+		bool shared() const						{ return _shared && (_forwardOf(_shared) || _refs(_shared) > 1); }
+
+		void swap(node_pool& other) {
+			std::swap(allocator(), other.allocator());
+			std::swap(_shared, other._shared);
+		}
+
+		allocator_type get_allocator() const	{ return allocator(); }
+		allocator_type& allocator()				{ return *this; }
+		const allocator_type& allocator() const	{ return *this; }
+
+	private:
+		static node_type*& _nextFree(node_type* n) { return *reinterpret_cast<node_type**>(n); }
+
+		static void _push(_state* s, node_type* n) {
+			if (!s->free)
+				s->free_tail = n;
+			_nextFree(n) = s->free;
+			s->free = n;
+		}
+
+#if __cplusplus >= 201103L
+		static size_type _refs(_state* s)			{ return s->refs.load(std::memory_order_acquire); }
+		static void _retain(_state* s)				{ s->refs.fetch_add(1, std::memory_order_relaxed); }
+		static bool _release(_state* s)				{ return s->refs.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+		static _state* _forwardOf(_state* s)		{ return s->forward.load(std::memory_order_acquire); }
+		static void _setForward(_state* s, _state* to)	{ s->forward.store(to, std::memory_order_release); }
+		static void _lockState(_state* s)			{ s->mutex.lock(); }
+		static void _unlock(_state* s)				{ s->mutex.unlock(); }
+#else
+		static size_type _refs(_state* s)			{ return s->refs; }
+		static void _retain(_state* s)				{ s->refs++; }
+		static bool _release(_state* s)				{ return --s->refs == 0; }
+		static _state* _forwardOf(_state* s)		{ return s->forward; }
+		static void _setForward(_state* s, _state* to)	{ s->forward = to; }
+		static void _lockState(_state*)				{}
+		static void _unlock(_state*)				{}
+#endif
+
+		/* follows the states forwarded to since this pool last looked, holding the last one instead */
+		void _resolve() {
+			while (_state* next = _forwardOf(_shared)) {
+				_retain(next);
+				_drop(_shared);
+				_shared = next;
+			}
+		}
+
+		/* the current state, locked unless this pool holds it alone: then no
+			other owner exists that could share it or take a node from it meanwhile */
+		_state* _lock(bool& locked) {
+			while (true) {
+				_resolve();
+				_state* s = _shared;
+				locked = (_refs(s) > 1);
+				if (!locked)
+					return s;
+				_lockState(s);
+				if (!_forwardOf(s))
+					return s;
+				_unlock(s);
+			}
+		}
+
+		/* b, locked and forwarding nowhere, joins a, locked as well */
+		void _unite(_state* a, _state* b) {
+			if (b->slabs) {
+				_slab* last = b->slabs;
+				while (last->next)
+					last = last->next;
+				last->next = a->slabs;
+				a->slabs = b->slabs;
+			}
+			if (b->free) {
+				if (!a->free)
+					a->free_tail = b->free_tail;
+				_nextFree(b->free_tail) = a->free;
+				a->free = b->free;
+			}
+			if (b->slab_end - b->cursor > a->slab_end - a->cursor) {
+				std::swap(a->cursor, b->cursor);
+				std::swap(a->slab_end, b->slab_end);
+			}
+			while (b->cursor != b->slab_end)
+				_push(a, b->cursor++);
+			a->next_slab = std::max(a->next_slab, b->next_slab);
+			a->reserved = 0;
+			b->slabs = NULL;
+			b->free = NULL;
+			_retain(a);
+			_setForward(b, a);
+		}
+
+		/* drops a reference to s. The last one destroys it: a state forwarded
+			elsewhere lives in a slab of the one it joined, which it lets go of in
+			turn, the others give their slabs back. */
+		void _drop(_state* s) {
+			while (s && _release(s)) {
+				_state*	next = _forwardOf(s);
+				_slab*	slabs = s->slabs;
+				s->~_state();
+				while (slabs) {
+					_slab* following = slabs->next;
+					allocator().deallocate(reinterpret_cast<node_type*>(slabs), slabs->count);
+					slabs = following;
+				}
+				s = next;
+			}
+		}
+
+		/* the first slab, of nodes nodes, with the state of the pool after its header */
+		void _create(size_type nodes) {
+			size_type	count = nodes + _state_slots;
+			node_type*	raw = allocator().allocate(count);
+			_slab*		slab = reinterpret_cast<_slab*>(raw);
+			_state*		s = ::new (static_cast<void*>(slab + 1)) _state();
+			slab->next = NULL;
+			slab->count = count;
+			s->slabs = slab;
+			s->cursor = raw + _state_slots;
+			s->slab_end = raw + count;
+			if (nodes >= s->next_slab)
+				s->next_slab = std::min<size_type>(nodes * 2, FT_NODE_POOL_MAX_SLAB);
+			else
+				s->next_slab *= 2;
+			_shared = s;
+		}
+
+		void _newSlab(_state* s, size_type nodes) {
+			size_type	count = nodes + _header_slots;
+			node_type*	raw = allocator().allocate(count);
+			_slab*		slab = reinterpret_cast<_slab*>(raw);
+			slab->next = s->slabs;
+			slab->count = count;
+			s->slabs = slab;
+			s->cursor = raw + _header_slots;
+			s->slab_end = raw + count;
+			if (s->next_slab < FT_NODE_POOL_MAX_SLAB)
+				s->next_slab *= 2;
+		}
+};
+
+}
+
+#endif
@@ -6,10 +6,15 @@ ABOUT:
 #ifndef PAIR_HPP
 #define PAIR_HPP
 
+#include "utils.hpp"
+
 namespace ft {
 	
 	template<class T1, class T2>
 	struct pair {
+		typedef T1 first_type;
+		typedef T2 second_type;
+
 		T1 first;
 		T2 second;
 		pair() : first(), second() {}
@@ -24,6 +29,25 @@ namespace ft {
 			return *this;
 		}
 
+#if __cplusplus >= 201103L
+		/* the user-declared operator= above would otherwise suppress the implicit moves */
+		pair(const pair&) = default;
+		pair(pair&&) = default;
+
+		template <class U1, class U2, class = typename ft::enable_if<std::is_constructible<T1, U1&&>::value
+			&& std::is_constructible<T2, U2&&>::value>::type>
+		pair(U1&& x, U2&& y) : first(ft::forward<U1>(x)), second(ft::forward<U2>(y)) {}
+
+		template <class U1, class U2>
+		pair(pair<U1, U2>&& p) : first(ft::forward<U1>(p.first)), second(ft::forward<U2>(p.second)) {}
+
+		pair& operator=(pair&& p) {
+			first = ft::move(p.first);
+			second = ft::move(p.second);
+			return *this;
+		}
+#endif
+
 		void swap(pair& p) {
 			std::swap(first,  p.first);
 			std::swap(second, p.second);
@@ -49,7 +73,7 @@ namespace ft {
 	inline bool operator<=(const pair<T1, T2>& x, const pair<T1, T2>& y) { return !(y < x); }
 
 	template <class T1, class T2>
-	inline pair<T1, T2> make_pair(T1 x, T2 y) { return pair<T1, T2>(x, y); }
+	inline pair<T1, T2> make_pair(T1 x, T2 y) { return pair<T1, T2>(ft::move(x), ft::move(y)); }
 }
 
 #endif
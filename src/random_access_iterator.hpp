@@ -1,6 +1,10 @@
 /*
 	Random-access iterators allow to access elements
 	at an arbitrary offset position relative to the element they point to.
+
+	The iterator is a bare pointer wrapper: no virtual functions and the implicit
+	copy and destructor, so it is trivially copyable, has the size of a pointer
+	and loops over it optimise like loops over a raw pointer.
 */
 
 #ifndef RANDOM_ACCESS_ITERATOR_HPP
@@ -25,15 +29,6 @@ namespace ft {
 	public:
 		random_access_iterator() : _data(NULL) {}
 		random_access_iterator(pointer item) : _data(item) {}
-		random_access_iterator(const random_access_iterator& other) : _data(other._data) {}
-		virtual ~random_access_iterator() {}
-
-		random_access_iterator &operator=(const random_access_iterator& other) {
-			if (this == &other)
-				return (*this);
-			this->_data = other._data;
-			return (*this);
-		}
 
 		pointer base() const 										{ return (_data); }
 		reference operator *() const 								{ return (*_data); }
@@ -50,6 +45,21 @@ namespace ft {
 		operator random_access_iterator<const T> () const			{ return (random_access_iterator<const T>(this->_data)); }
 	};
 
+	template <typename T>
+	struct is_trivially_copyable< ft::random_access_iterator<T> > : public ft::true_type {};
+
+	template <typename T>
+	struct contiguous_iterator_traits< ft::random_access_iterator<T> > : public ft::true_type {
+		typedef T		value_type;
+		static const T* address(const ft::random_access_iterator<T>& it) { return it.base(); }
+	};
+
+	template <typename T>
+	struct contiguous_iterator_traits< ft::random_access_iterator<const T> > : public ft::true_type {
+		typedef T		value_type;
+		static const T* address(const ft::random_access_iterator<const T>& it) { return it.base(); }
+	};
+
 	template <typename T>
 	typename ft::random_access_iterator<T>::difference_type
 	operator ==(const ft::random_access_iterator<T> lhs, const ft::random_access_iterator<T> rhs) {
@@ -0,0 +1,102 @@
+/*
+ABOUT:
+	realloc_allocator - malloc/free based allocator that can also grow a block in place
+
+	ft::vector of a trivially copyable type over this allocator grows its buffer with
+	reallocate() instead of allocate + copy + deallocate. glibc serves large blocks
+	with mmap, so their realloc is an mremap: the pages are remapped, nothing is copied
+	and the old and new buffers never coexist.
+
+	Any other allocator with the same reallocate(p, old_n, new_n) member opts in
+	with a specialization of both traits, as long as its construct/destroy are plain copies:
+		template <class T> struct ft::is_realloc_allocator< my_alloc<T> > : public ft::true_type {};
+		template <class T> struct ft::is_plain_allocator< my_alloc<T> > : public ft::true_type {};
+*/
+
+#ifndef REALLOC_ALLOCATOR_HPP
+#define REALLOC_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#include "utils.hpp"
+
+namespace ft {
+
+	template<class T>
+	class realloc_allocator {
+	public:
+		typedef T			value_type;
+		typedef T*			pointer;
+		typedef const T*	const_pointer;
+		typedef T&			reference;
+		typedef const T&	const_reference;
+		typedef size_t		size_type;
+		typedef ptrdiff_t	difference_type;
+
+		template<class U>
+		struct rebind { typedef realloc_allocator<U> other; };
+
+		realloc_allocator() {}
+		realloc_allocator(const realloc_allocator&) {}
+		template<class U>
+		realloc_allocator(const realloc_allocator<U>&) {}
+		~realloc_allocator() {}
+
+		pointer address(reference x) const				{ return &x; }
+		const_pointer address(const_reference x) const	{ return &x; }
+		size_type max_size() const						{ return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+		pointer allocate(size_type n, const void* = 0) {
+			if (n > max_size())
+				throw (std::bad_alloc());
+			void* p = std::malloc(n * sizeof(T));
+			if (!p && n)
+				throw (std::bad_alloc());
+			return static_cast<pointer>(p);
+		}
+
+		void deallocate(pointer p, size_type) { std::free(p); }
+
+		/* grows or shrinks the block of old_n elements at p to new_n, moving
+			its bytes only if it cannot be resized where it is; p may be NULL */
+		pointer reallocate(pointer p, size_type, size_type new_n) {
+			if (new_n > max_size())
+				throw (std::bad_alloc());
+			void* q = std::realloc(p, new_n * sizeof(T));
+			if (!q && new_n)
+				throw (std::bad_alloc());
+			return static_cast<pointer>(q);
+		}
+
+#if __cplusplus >= 201103L
+		template<class U, class... Args>
+		void construct(U* p, Args&&... args)		{ ::new (static_cast<void*>(p)) U(ft::forward<Args>(args)...); }
+#else
+		void construct(pointer p, const T& value)	{ ::new (static_cast<void*>(p)) T(value); }
+#endif
+		void destroy(pointer p)						{ p->~T(); }
+	};
+
+	template<class T, class U>
+	bool operator==(const realloc_allocator<T>&, const realloc_allocator<U>&) { return true; }
+
+	template<class T, class U>
+	bool operator!=(const realloc_allocator<T>&, const realloc_allocator<U>&) { return false; }
+
+
+// Trait class that identifies allocators providing reallocate(p, old_n, new_n).
+	template<class Alloc>
+	struct is_realloc_allocator : public false_type {};
+
+	template<class T>
+	struct is_realloc_allocator< realloc_allocator<T> > : public true_type {};
+
+	template<class T>
+	struct is_plain_allocator< realloc_allocator<T> > : public true_type {};
+
+}
+
+#endif
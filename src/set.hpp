@@ -10,10 +10,10 @@
 
 namespace ft {
 
-template<class Key, class Compare = std::less<Key>, class Alloc = std::allocator<Key> >
+template<class Key, class Compare = std::less<Key>, class Alloc = std::allocator<Key>, class Policy = ft::tree_plain>
 class set {
 	private:
-		typedef ft::_Rb_tree<Key, Compare, Alloc>		set_tree;
+		typedef ft::_Rb_tree<Key, Key, ft::_Identity<Key>, Compare, Alloc, Policy>	set_tree;
 		typedef typename set_tree::node					set_node;
 
 	public:
@@ -24,6 +24,7 @@ class set {
 		typedef Key										value_type;
 		typedef Compare									key_compare;
 		typedef Compare									value_compare;
+		typedef Policy									tree_policy;
 		typedef value_type&								reference;
 		typedef const value_type&						const_reference;
 		typedef typename allocator_type::pointer		pointer;
@@ -32,37 +33,46 @@ class set {
 		typedef typename set_tree::const_iterator		const_iterator;
 		typedef ft::reverse_iterator<iterator>			reverse_iterator;
 		typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+		typedef typename set_tree::node_handle			node_type;
+		typedef ft::node_insert_return<iterator, node_type>	insert_return_type;
 
 	private:
 		set_tree		_set_tree;
-		allocator_type	_set_alloc;
 
 	public:
-		explicit set(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _set_tree(comp), _set_alloc(alloc) {}
+		explicit set(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _set_tree(comp, alloc) {}
 
 		template<class InputIterator>
 		set(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
-		: _set_tree(comp), _set_alloc(alloc) {
-			for (; first != last; first++) {
-				_set_tree.insert(*first);
-			}
-		}
+		: _set_tree(comp, alloc) { _set_tree.insert_range(first, last); }
+
+		template<class ForwardIterator>
+		set(ft::sorted_unique_t, ForwardIterator first, ForwardIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+		: _set_tree(comp, alloc) { _set_tree.insert_range(ft::sorted_unique, first, last); }
 
-		set(const set& other) : _set_tree(other._set_tree), _set_alloc(other._set_alloc) {}
+		set(const set& other) : _set_tree(other._set_tree) {}
 		~set() {}
 
 		set& operator=(const set& other) {
 			if (this == &other)
 				return *this;
 			_set_tree = other._set_tree;
-			_set_alloc = other._set_alloc;
 			return *this;
 		}
 
+#if __cplusplus >= 201103L
+		set(set&& other) : _set_tree(ft::move(other._set_tree)) {}
+
+		set& operator=(set&& other) {
+			_set_tree = ft::move(other._set_tree);
+			return *this;
+		}
+#endif
+
 		bool empty() const 											{ return _set_tree.empty(); }
 		size_type size() const										{ return _set_tree.size(); }
 		size_type max_size() const 									{ return _set_tree.max_size(); }
-		allocator_type get_allocator() const 						{ return allocator_type(); }
+		allocator_type get_allocator() const 						{ return allocator_type(_set_tree.get_allocator()); }
 		iterator begin() 											{ return _set_tree.begin(); }
 		const_iterator begin() const 								{ return _set_tree.begin(); }
 		iterator end()												{ return _set_tree.end(); }
@@ -74,111 +84,114 @@ class set {
 		void clear()												{ _set_tree.clear(); }
 		ft::pair<iterator, bool> insert(const value_type& val)		{ return _set_tree.insert(val); }
 		iterator insert(iterator hint, const value_type& val)		{ return _set_tree.insert(hint, val); }
-		key_compare key_comp() const 								{ return key_compare(); }
-		value_compare value_comp() const 							{ return value_compare(); }
+		key_compare key_comp() const 								{ return _set_tree.key_comp(); }
+		value_compare value_comp() const 							{ return _set_tree.key_comp(); }
 		void erase(iterator pos)									{ _set_tree.erase(pos); }
 		size_type erase(const key_type& key) 						{ return _set_tree.erase(key); }
 		void swap(set& other)										{ _set_tree.swap(other._set_tree); }
 
-		template<class ItInput>
-		void insert(ItInput first, ItInput last) {
-			for(; first != last; first++)
-				_set_tree.insert(*first);
-		}
+#if __cplusplus >= 201103L
+		ft::pair<iterator, bool> insert(value_type&& val)			{ return _set_tree.insert(ft::move(val)); }
+		iterator insert(iterator hint, value_type&& val)			{ return _set_tree.insert(hint, ft::move(val)); }
 
-		void erase(iterator first, iterator last) { 
-			while (first != last)
-				first = _set_tree.erase(first);
-		}
+		template<class... Args>
+		ft::pair<iterator, bool> emplace(Args&&... args)			{ return _set_tree.emplace(ft::forward<Args>(args)...); }
 
-		size_type count(const key_type& key) const {
-			if (!size())
-				return 0;
-			const_iterator it = _set_tree.find(key);
-			return (!key_comp()(*it, key) && !key_comp()(key, *it)) ? 1 : 0;
-		}
+		template<class... Args>
+		iterator emplace_hint(iterator hint, Args&&... args)		{ return _set_tree.emplace_hint(hint, ft::forward<Args>(args)...); }
+#endif
 
-		iterator find(const key_type& key) {
-			if (!size())
-				return end();
-			iterator it = _set_tree.find(key);
-			return (!key_comp()(*it, key) && !key_comp()(key, *it)) ? it : end();
+		/* node handles: extract() unlinks the element's node, which insert() links into
+			a set of the same type as it is, and merge() relinks the nodes of other:
+			with equal allocators the sets share their node pools from then on */
+		node_type extract(iterator pos)								{ return _set_tree.extract(pos); }
+		node_type extract(const key_type& key)						{ return _set_tree.extract(key); }
+		iterator insert(iterator hint, node_type nh)				{ return _set_tree.insert(hint, nh); }
+		void merge(set& other)										{ _set_tree.merge(other._set_tree); }
+
+		/* moves the elements not less than key into the returned set, in O(log n)
+			relinks and O(k) to count the smaller part, see map::split_off */
+		set split_off(const key_type& key) {
+			set	right(key_comp(), get_allocator());
+			_set_tree.split(key, right._set_tree);
+			return right;
 		}
 
-		const_iterator find(const key_type& key) const {
-			if (!size())
-				return end();
-			const_iterator it = _set_tree.find(key);
-			return (!key_comp()(*it, key) && !key_comp()(key, *it)) ? it : end();
-		}
+		/* takes over every element of other, whose range must lie before or after this one,
+			in O(log n) relinks */
+		void append(set& other)										{ _set_tree.join(other._set_tree); }
 
-		ft::pair<iterator, iterator> equal_range(const key_type& key) {
-			iterator first = lower_bound(key);
-			iterator second = upper_bound(key);
-			return ft::make_pair<iterator, iterator>(first, second);
-		}
+#if __cplusplus >= 201103L
+		void append(set&& other)									{ _set_tree.join(other._set_tree); }
+#endif
 
-		ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
-			const_iterator first = lower_bound(key);
-			const_iterator second = upper_bound(key);
-			return ft::make_pair<const_iterator, const_iterator>(first, second);
+		insert_return_type insert(node_type nh) {
+			ft::pair<iterator, bool>	inserted = _set_tree.insert(nh);
+			insert_return_type			ret;
+			ret.position = inserted.first;
+			ret.inserted = inserted.second;
+			ret.node = ft::move(nh);
+			return ret;
 		}
 
-		iterator lower_bound(const key_type& key) {
-			if (!size()) return end();
-			iterator	it = _set_tree.find(key);
-			return (*it <key) ? ++it : it;
-		}
+		template<class ItInput>
+		void insert(ItInput first, ItInput last)	{ _set_tree.insert_range(first, last); }
 
-		const_iterator lower_bound(const key_type& key) const {
-			if (!size())
-				return end();
-			const_iterator	it = _set_tree.find(key);
-			return (*it <key) ? ++it : it;
-		}
+		template<class ForwardIterator>
+		void insert(ft::sorted_unique_t, ForwardIterator first, ForwardIterator last)	{ _set_tree.insert_range(ft::sorted_unique, first, last); }
 
-		iterator upper_bound(const key_type& key) {
-			if (!size())
-				return end();
-			iterator it = _set_tree.find(key);
-			return (*it <= key) ? ++it : it;
+		void erase(iterator first, iterator last) { 
+			while (first != last)
+				first = _set_tree.erase(first);
 		}
 
-		const_iterator upper_bound(const key_type& key) const {
-			if (!size())
-				return end();
-			const_iterator it = _set_tree.find(key);
-			return  (*it <= key) ? ++it : it;
-		}
+		size_type count(const key_type& key) const		{ return _set_tree.count(key); }
+		iterator find(const key_type& key)				{ return _set_tree.find(key); }
+		const_iterator find(const key_type& key) const	{ return _set_tree.find(key); }
+
+		ft::pair<iterator, iterator> equal_range(const key_type& key)					{ return _set_tree.equal_range(key); }
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const	{ return _set_tree.equal_range(key); }
+
+		/* O(log n) with Policy = ft::tree_order_statistics, not available otherwise */
+		iterator nth(size_type k) const												{ return _set_tree.nth(k); }
+		size_type rank(const key_type& key) const									{ return _set_tree.rank(key); }
+		difference_type distance(const_iterator first, const_iterator last) const	{ return _set_tree.distance(first, last); }
+
+		/* O(log n) with Policy = ft::tree_aggregate<Monoid>: the monoid folded over the elements in [lo, hi) */
+		typename Policy::summary_type aggregate(const key_type& lo, const key_type& hi) const	{ return _set_tree.aggregate(lo, hi); }
+		iterator lower_bound(const key_type& key)										{ return _set_tree.lower_bound(key); }
+		const_iterator lower_bound(const key_type& key) const							{ return _set_tree.lower_bound(key); }
+		iterator upper_bound(const key_type& key)										{ return _set_tree.upper_bound(key); }
+		const_iterator upper_bound(const key_type& key) const							{ return _set_tree.upper_bound(key); }
 
 
-	friend bool operator==(const ft::set<Key, Compare, Alloc>& lhs, const ft::set<Key, Compare, Alloc>& rhs) {
+	friend bool operator==(const ft::set<Key, Compare, Alloc, Policy>& lhs, const ft::set<Key, Compare, Alloc, Policy>& rhs) {
 		return (lhs._set_tree == rhs._set_tree);
 	}
 
-	friend bool operator!=(const ft::set<Key, Compare, Alloc>& lhs, const ft::set<Key, Compare, Alloc>& rhs) {
+	friend bool operator!=(const ft::set<Key, Compare, Alloc, Policy>& lhs, const ft::set<Key, Compare, Alloc, Policy>& rhs) {
 		return (!(lhs == rhs));
 	}
 
-	friend bool operator<(const ft::set<Key, Compare, Alloc>& lhs, const ft::set<Key, Compare, Alloc>& rhs) {
+	friend bool operator<(const ft::set<Key, Compare, Alloc, Policy>& lhs, const ft::set<Key, Compare, Alloc, Policy>& rhs) {
 		return (lhs._set_tree <rhs._set_tree);
 	}
 
-	friend bool operator>=(const ft::set<Key, Compare, Alloc>& lhs, const ft::set<Key, Compare, Alloc>& rhs) {
+	friend bool operator>=(const ft::set<Key, Compare, Alloc, Policy>& lhs, const ft::set<Key, Compare, Alloc, Policy>& rhs) {
 		return (!(lhs <rhs));
 	}
 
-	friend bool operator>(const ft::set<Key, Compare, Alloc>& lhs, const ft::set<Key, Compare, Alloc>& rhs) {
+	friend bool operator>(const ft::set<Key, Compare, Alloc, Policy>& lhs, const ft::set<Key, Compare, Alloc, Policy>& rhs) {
 		return (rhs <lhs);
 	}
 
-	friend bool operator<=(const ft::set<Key, Compare, Alloc>& lhs, const ft::set<Key, Compare, Alloc>& rhs) {
+	friend bool operator<=(const ft::set<Key, Compare, Alloc, Policy>& lhs, const ft::set<Key, Compare, Alloc, Policy>& rhs) {
 		return (!(rhs <lhs));
 	}
 };
 
-	template<class Key, class Compare, class Alloc>
-	void swap(ft::set<Key, Compare, Alloc>& lhs, ft::set<Key, Compare, Alloc>& rhs) { lhs.swap(rhs); }
+	template<class Key, class Compare, class Alloc, class Policy>
+	void swap(ft::set<Key, Compare, Alloc, Policy>& lhs, ft::set<Key, Compare, Alloc, Policy>& rhs) { lhs.swap(rhs); }
 }
 
 #endif
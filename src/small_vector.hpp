@@ -0,0 +1,234 @@
+/*
+ABOUT:
+	small_vector - ft::vector that keeps its first N elements inside the object
+
+	The storage for N elements is part of the small_vector itself, so a collection
+	that never holds more than N elements never touches the heap. The first growth
+	past N moves the elements to a heap block obtained from Alloc, exactly like
+	ft::vector does, and the inline storage is left unused from then on.
+
+	The container is an ft::vector over an inline_allocator: the allocator hands out
+	the inline storage for the first block and forwards every other request to Alloc.
+	Iterators, growth, insert/erase and the comparison operators are the vector's own.
+
+	Unlike ft::vector, swap() copies the elements whenever one side is inline:
+	the inline storage cannot change owner.
+	The inline storage is aligned for any scalar type, over-aligned types are not supported.
+*/
+
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include <cstddef>
+#include <memory>
+
+#include "utils.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+	/* raw storage for N elements, _inline_used tells whether an allocator handed it out */
+	template<class T, size_t N>
+	struct _small_buffer {
+		union {
+			unsigned char	bytes[sizeof(T) * N];
+			long double		align_ld;
+			long long		align_ll;
+			void*			align_p;
+		}		_inline;
+		bool	_inline_used;
+
+		_small_buffer() : _inline_used(false) {}
+
+		T* _inline_data() { return reinterpret_cast<T*>(_inline.bytes); }
+	};
+
+	template<class T, size_t N, class Alloc = std::allocator<T> >
+	class inline_allocator : private Alloc {
+	public:
+		typedef typename Alloc::value_type			value_type;
+		typedef typename Alloc::pointer				pointer;
+		typedef typename Alloc::const_pointer		const_pointer;
+		typedef typename Alloc::reference			reference;
+		typedef typename Alloc::const_reference		const_reference;
+		typedef typename Alloc::size_type			size_type;
+		typedef typename Alloc::difference_type		difference_type;
+
+		/* a rebound allocator has no inline storage of its own */
+		template<class U>
+		struct rebind { typedef inline_allocator<U, N, typename Alloc::template rebind<U>::other> other; };
+
+	private:
+		_small_buffer<T, N>*	_buffer;
+
+	public:
+		inline_allocator() : Alloc(), _buffer(NULL) {}
+		explicit inline_allocator(_small_buffer<T, N>* buffer, const Alloc& alloc = Alloc()) : Alloc(alloc), _buffer(buffer) {}
+		inline_allocator(const inline_allocator& other) : Alloc(other.heap_allocator()), _buffer(other._buffer) {}
+		template<class U, class A>
+		inline_allocator(const inline_allocator<U, N, A>& other) : Alloc(other.heap_allocator()), _buffer(NULL) {}
+		~inline_allocator() {}
+
+		/* the inline storage stays with the container the allocator lives in */
+		inline_allocator& operator=(const inline_allocator& other) {
+			heap_allocator() = other.heap_allocator();
+			return *this;
+		}
+
+		pointer address(reference x) const				{ return heap_allocator().address(x); }
+		const_pointer address(const_reference x) const	{ return heap_allocator().address(x); }
+		size_type max_size() const						{ return heap_allocator().max_size(); }
+
+		pointer allocate(size_type n, const void* hint = 0) {
+			if (_buffer && !_buffer->_inline_used && n <= N) {
+				_buffer->_inline_used = true;
+				return _buffer->_inline_data();
+			}
+			return heap_allocator().allocate(n, hint);
+		}
+
+		void deallocate(pointer p, size_type n) {
+			if (_buffer && p == _buffer->_inline_data())
+				_buffer->_inline_used = false;
+			else
+				heap_allocator().deallocate(p, n);
+		}
+
+#if __cplusplus >= 201103L
+		template<class U, class... Args>
+		void construct(U* p, Args&&... args)				{ std::allocator_traits<Alloc>::construct(heap_allocator(), p, ft::forward<Args>(args)...); }
+#else
+		void construct(pointer p, const_reference value)	{ heap_allocator().construct(p, value); }
+#endif
+		void destroy(pointer p)								{ heap_allocator().destroy(p); }
+
+		Alloc& heap_allocator()								{ return *this; }
+		const Alloc& heap_allocator() const					{ return *this; }
+
+		friend bool operator==(const inline_allocator& lhs, const inline_allocator& rhs) {
+			return lhs._buffer == rhs._buffer && lhs.heap_allocator() == rhs.heap_allocator();
+		}
+		friend bool operator!=(const inline_allocator& lhs, const inline_allocator& rhs) { return !(lhs == rhs); }
+	};
+
+	template<class T, size_t N, class Alloc>
+	struct is_plain_allocator< inline_allocator<T, N, Alloc> > : public is_plain_allocator<Alloc> {};
+
+
+	template <class T, size_t N, class Alloc = std::allocator<T>, class Growth = ft::growth_factor_2 >
+	class small_vector : private _small_buffer<T, N>, private ft::vector<T, ft::inline_allocator<T, N, Alloc>, Growth> {
+		typedef _small_buffer<T, N>											_buffer;
+		typedef ft::vector<T, ft::inline_allocator<T, N, Alloc>, Growth>	_vector;
+		typedef typename _vector::allocator_type							_held_allocator;
+
+	public:
+		typedef typename _vector::value_type								value_type;
+		typedef Alloc														allocator_type;
+		typedef typename _vector::pointer									pointer;
+		typedef typename _vector::const_pointer								const_pointer;
+		typedef typename _vector::reference									reference;
+		typedef typename _vector::const_reference							const_reference;
+		typedef typename _vector::iterator									iterator;
+		typedef typename _vector::const_iterator							const_iterator;
+		typedef typename _vector::reverse_iterator							reverse_iterator;
+		typedef typename _vector::const_reverse_iterator					const_reverse_iterator;
+		typedef typename _vector::difference_type							difference_type;
+		typedef typename _vector::size_type									size_type;
+		typedef Growth														growth_policy;
+
+	private:
+		const _vector& _base() const { return *this; }
+
+		/* takes the inline storage, or a heap block right away if count cannot fit in it */
+		void _init(size_type count) { _vector::reserve(count > N ? count : N); }
+
+		/* an input range cannot be measured without being consumed */
+		template <class ForwardIt>
+		void _initRange(ForwardIt first, ForwardIt last, ft::true_type)		{ _init(ft::distance(first, last)); }
+		template <class InputIterator>
+		void _initRange(InputIterator, InputIterator, ft::false_type)		{ _init(0); }
+
+	public:
+		explicit small_vector(const allocator_type& alloc = allocator_type())
+		: _buffer(), _vector(_held_allocator(this, alloc)) { _init(0); }
+
+		explicit small_vector(size_type count, const value_type& value = value_type(), const allocator_type& alloc = allocator_type())
+		: _buffer(), _vector(_held_allocator(this, alloc)) {
+			_init(count);
+			_vector::insert(_vector::end(), count, value);
+		}
+
+		template <class InputIterator>
+		small_vector(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type(),
+		typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL)
+		: _buffer(), _vector(_held_allocator(this, alloc)) {
+			_initRange(first, last, ft::is_forward_iterator<InputIterator>());
+			_vector::insert(_vector::end(), first, last);
+		}
+
+		small_vector(const small_vector& other)
+		: _buffer(), _vector(_held_allocator(this, other.get_allocator())) {
+			_init(other.size());
+			_vector::insert(_vector::end(), other.begin(), other.end());
+		}
+
+		~small_vector() {}
+
+		small_vector& operator=(const small_vector& other) {
+			_vector::operator=(other._base());
+			return *this;
+		}
+
+		using _vector::begin;
+		using _vector::end;
+		using _vector::rbegin;
+		using _vector::rend;
+		using _vector::size;
+		using _vector::capacity;
+		using _vector::empty;
+		using _vector::max_size;
+		using _vector::operator[];
+		using _vector::front;
+		using _vector::back;
+		using _vector::at;
+		using _vector::push_back;
+		using _vector::pop_back;
+		using _vector::assign;
+		using _vector::insert;
+		using _vector::erase;
+		using _vector::resize;
+		using _vector::reserve;
+		using _vector::clear;
+#if __cplusplus >= 201103L
+		using _vector::emplace;
+		using _vector::emplace_back;
+#endif
+
+		/* true while the elements live in the inline storage */
+		bool is_inline() const							{ return this->_inline_used; }
+		allocator_type get_allocator() const			{ return _vector::get_allocator().heap_allocator(); }
+
+		/* two heap blocks trade places, inline elements can only be copied across */
+		void swap(small_vector& other) {
+			if (!this->is_inline() && !other.is_inline()) {
+				_vector::swap(other);
+				return ;
+			}
+			small_vector tmp(*this);
+			*this = other;
+			other = tmp;
+		}
+
+		friend bool operator==(const small_vector& lhs, const small_vector& rhs)	{ return lhs._base() == rhs._base(); }
+		friend bool operator!=(const small_vector& lhs, const small_vector& rhs)	{ return lhs._base() != rhs._base(); }
+		friend bool operator<(const small_vector& lhs, const small_vector& rhs)		{ return lhs._base() < rhs._base(); }
+		friend bool operator<=(const small_vector& lhs, const small_vector& rhs)	{ return lhs._base() <= rhs._base(); }
+		friend bool operator>(const small_vector& lhs, const small_vector& rhs)		{ return lhs._base() > rhs._base(); }
+		friend bool operator>=(const small_vector& lhs, const small_vector& rhs)	{ return lhs._base() >= rhs._base(); }
+	};
+
+	template <class T, size_t N, class Alloc, class Growth>
+	void swap(small_vector<T, N, Alloc, Growth>& one, small_vector<T, N, Alloc, Growth>& other) { one.swap(other); }
+}
+
+#endif
@@ -29,6 +29,17 @@ namespace ft {
 			_container = other._container;
 			return *this;
 		};
+#if __cplusplus >= 201103L
+		explicit stack(Container&& cont) : _container(ft::move(cont))	{}
+		stack(stack&& other) : _container(ft::move(other._container))	{}
+		stack& operator=(stack&& other) {
+			_container = ft::move(other._container);
+			return *this;
+		}
+		void push(value_type&& value)								{ _container.push_back(ft::move(value)); }
+		template<class... Args>
+		void emplace(Args&&... args)								{ _container.emplace_back(ft::forward<Args>(args)...); }
+#endif
 		reference top()												{ return _container.back(); };
 		const_reference top() const									{ return _container.back(); };
 		bool empty() const 											{ return _container.empty(); };
@@ -0,0 +1,272 @@
+/*
+ABOUT:
+	static_vector - ft::vector with a fixed capacity of N elements and no heap at all
+
+	The N slots are part of the object, like the inline storage of ft::small_vector,
+	but there is no heap to spill to: capacity() and max_size() are always N.
+	An operation that would need more than N elements is an overflow, and the
+	Overflow policy decides what happens to it:
+
+		overflow_throw		throws std::length_error, the default
+		overflow_report		refuses the operation, which leaves the container
+							unchanged and raises the overflowed() flag
+							until reset_overflow()
+
+	Either way the container is left as it was before the operation.
+	try_push_back() reports a full container through its return value under any policy.
+	ft::stack<T, ft::static_vector<T, N> > is a bounded stack that never allocates.
+*/
+
+#ifndef STATIC_VECTOR_HPP
+#define STATIC_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#include "small_vector.hpp"
+#include "utils.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+	struct overflow_throw {
+		static void overflow(const char* what) { throw (std::length_error(what)); }
+	};
+
+	struct overflow_report {
+		static void overflow(const char*) {}
+	};
+
+	/* the heap side of a static_vector's inline_allocator, never reached:
+		every operation checks the capacity before the vector can grow */
+	template<class T>
+	struct _no_heap_allocator : public std::allocator<T> {
+		typedef typename std::allocator<T>::pointer		pointer;
+		typedef typename std::allocator<T>::size_type	size_type;
+
+		template<class U>
+		struct rebind { typedef _no_heap_allocator<U> other; };
+
+		_no_heap_allocator() {}
+		template<class U>
+		_no_heap_allocator(const _no_heap_allocator<U>&) {}
+
+		pointer allocate(size_type, const void* = 0) { throw (std::bad_alloc()); }
+	};
+
+	template<class T>
+	struct is_plain_allocator< _no_heap_allocator<T> > : public integral_constant<bool, true> {};
+
+
+	template <class T, size_t N, class Overflow = ft::overflow_throw >
+	class static_vector : private _small_buffer<T, N>, private ft::vector<T, ft::inline_allocator<T, N, ft::_no_heap_allocator<T> > > {
+		typedef _small_buffer<T, N>															_buffer;
+		typedef ft::vector<T, ft::inline_allocator<T, N, ft::_no_heap_allocator<T> > >	_vector;
+		typedef typename _vector::allocator_type											_held_allocator;
+
+	public:
+		typedef typename _vector::value_type								value_type;
+		typedef typename _vector::pointer									pointer;
+		typedef typename _vector::const_pointer								const_pointer;
+		typedef typename _vector::reference									reference;
+		typedef typename _vector::const_reference							const_reference;
+		typedef typename _vector::iterator									iterator;
+		typedef typename _vector::const_iterator							const_iterator;
+		typedef typename _vector::reverse_iterator							reverse_iterator;
+		typedef typename _vector::const_reverse_iterator					const_reverse_iterator;
+		typedef typename _vector::difference_type							difference_type;
+		typedef typename _vector::size_type									size_type;
+		typedef Overflow													overflow_policy;
+
+	private:
+		bool	_overflowed;
+
+		const _vector& _base() const { return *this; }
+
+		/* hands the overflow to the policy, returns false if it lets the caller go on */
+		bool _refuse(const char* what) {
+			_overflowed = true;
+			Overflow::overflow(what);
+			return false;
+		}
+
+		bool _fits(size_type count, const char* what)		{ return count <= N || _refuse(what); }
+		bool _fitsMore(size_type extra, const char* what)	{ return extra <= N - this->size() || _refuse(what); }
+
+		/* a forward range is measured before anything is touched, an input range
+			can only be read once: it is appended and taken back if it overflows */
+		template <class ForwardIt>
+		bool _append(ForwardIt first, ForwardIt last, const char* what, ft::true_type) {
+			if (!_fitsMore(ft::distance(first, last), what))
+				return false;
+			_vector::insert(_vector::end(), first, last);
+			return true;
+		}
+
+		template <class InputIterator>
+		bool _append(InputIterator first, InputIterator last, const char* what, ft::false_type) {
+			size_type old_size = this->size();
+			for (; first != last; ++first) {
+				if (this->full()) {
+					_vector::erase(_vector::begin() + old_size, _vector::end());
+					return _refuse(what);
+				}
+				_vector::push_back(*first);
+			}
+			return true;
+		}
+
+		template <class ForwardIt>
+		void _insertRange(iterator pos, ForwardIt first, ForwardIt last, ft::true_type) {
+			if (_fitsMore(ft::distance(first, last), "static_vector::insert (range)"))
+				_vector::insert(pos, first, last);
+		}
+
+		template <class InputIterator>
+		void _insertRange(iterator pos, InputIterator first, InputIterator last, ft::false_type) {
+			size_type offset = pos - this->begin();
+			size_type old_size = this->size();
+			if (_append(first, last, "static_vector::insert (range)", ft::false_type()))
+				std::rotate(this->begin() + offset, this->begin() + old_size, this->end());
+		}
+
+	public:
+		static_vector() : _buffer(), _vector(_held_allocator(this)), _overflowed(false) {
+			_vector::reserve(N);
+		}
+
+		explicit static_vector(size_type count, const value_type& value = value_type())
+		: _buffer(), _vector(_held_allocator(this)), _overflowed(false) {
+			_vector::reserve(N);
+			if (_fits(count, "static_vector::static_vector"))
+				_vector::insert(_vector::end(), count, value);
+		}
+
+		template <class InputIterator>
+		static_vector(InputIterator first, InputIterator last,
+		typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL)
+		: _buffer(), _vector(_held_allocator(this)), _overflowed(false) {
+			_vector::reserve(N);
+			_append(first, last, "static_vector::static_vector", ft::is_forward_iterator<InputIterator>());
+		}
+
+		static_vector(const static_vector& other) : _buffer(), _vector(_held_allocator(this)), _overflowed(false) {
+			_vector::reserve(N);
+			_vector::insert(_vector::end(), other.begin(), other.end());
+		}
+
+		~static_vector() {}
+
+		static_vector& operator=(const static_vector& other) {
+			_vector::operator=(other._base());
+			return *this;
+		}
+
+		using _vector::begin;
+		using _vector::end;
+		using _vector::rbegin;
+		using _vector::rend;
+		using _vector::size;
+		using _vector::capacity;
+		using _vector::empty;
+		using _vector::operator[];
+		using _vector::front;
+		using _vector::back;
+		using _vector::at;
+		using _vector::pop_back;
+		using _vector::erase;
+		using _vector::clear;
+
+		size_type max_size() const						{ return N; }
+		bool full() const								{ return this->size() == N; }
+		bool overflowed() const							{ return _overflowed; }
+		void reset_overflow()							{ _overflowed = false; }
+
+		void reserve(size_type new_cap)					{ _fits(new_cap, "static_vector::reserve"); }
+
+		void resize(size_type count, value_type value = value_type()) {
+			if (_fits(count, "static_vector::resize"))
+				_vector::resize(count, value);
+		}
+
+		void push_back(const value_type& value) {
+			if (!this->full() || _refuse("static_vector::push_back"))
+				_vector::push_back(value);
+		}
+
+#if __cplusplus >= 201103L
+		void push_back(value_type&& value) {
+			if (!this->full() || _refuse("static_vector::push_back"))
+				_vector::push_back(ft::move(value));
+		}
+
+		template <class... Args>
+		void emplace_back(Args&&... args) {
+			if (!this->full() || _refuse("static_vector::emplace_back"))
+				_vector::emplace_back(ft::forward<Args>(args)...);
+		}
+#endif
+
+		bool try_push_back(const value_type& value) {
+			if (this->full())
+				return false;
+			_vector::push_back(value);
+			return true;
+		}
+
+		void assign(size_type count, const value_type& value) {
+			if (_fits(count, "static_vector::assign"))
+				_vector::assign(count, value);
+		}
+
+		template <class InputIterator>
+		void assign(InputIterator first, InputIterator last,
+		typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) {
+			static_vector tmp;
+			if (tmp._append(first, last, "static_vector::assign", ft::is_forward_iterator<InputIterator>()))
+				*this = tmp;
+			else
+				_overflowed = true;
+		}
+
+		/* returns pos when the insertion is refused */
+		iterator insert(iterator pos, const value_type& value) {
+			if (!_fitsMore(1, "static_vector::insert"))
+				return pos;
+			return _vector::insert(pos, value);
+		}
+
+		void insert(iterator pos, size_type count, const value_type& value) {
+			if (_fitsMore(count, "static_vector::insert (fill)"))
+				_vector::insert(pos, count, value);
+		}
+
+		template <class InputIterator>
+		void insert(iterator pos, InputIterator first, InputIterator last,
+		typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) {
+			_insertRange(pos, first, last, ft::is_forward_iterator<InputIterator>());
+		}
+
+		/* both sides are inline, the elements are copied across */
+		void swap(static_vector& other) {
+			static_vector tmp(*this);
+			*this = other;
+			other = tmp;
+		}
+
+		friend bool operator==(const static_vector& lhs, const static_vector& rhs)	{ return lhs._base() == rhs._base(); }
+		friend bool operator!=(const static_vector& lhs, const static_vector& rhs)	{ return lhs._base() != rhs._base(); }
+		friend bool operator<(const static_vector& lhs, const static_vector& rhs)	{ return lhs._base() < rhs._base(); }
+		friend bool operator<=(const static_vector& lhs, const static_vector& rhs)	{ return lhs._base() <= rhs._base(); }
+		friend bool operator>(const static_vector& lhs, const static_vector& rhs)	{ return lhs._base() > rhs._base(); }
+		friend bool operator>=(const static_vector& lhs, const static_vector& rhs)	{ return lhs._base() >= rhs._base(); }
+	};
+
+	template <class T, size_t N, class Overflow>
+	void swap(static_vector<T, N, Overflow>& one, static_vector<T, N, Overflow>& other) { one.swap(other); }
+}
+
+#endif
@@ -15,92 +15,264 @@ ABOUT:
 #define TREE_HPP
 
 #include "iterator_traits.hpp"
+#include "node_pool.hpp"
 #include "pair.hpp"
 #include "tree_iterator.hpp"
+#include "tree_policy.hpp"
 #include "utils.hpp"
 
 #include <limits>
 #include <iostream>
+#include <new>
 
 namespace ft {
 
 enum _Rb_tree_color { BLACK, RED };
 
-template<class T, class Compare = std::less<T> >
-class node {
+/* key extractors, the tree orders its values by KeyOfValue()(value) */
+template<class T>
+struct _Identity {
+	const T& operator()(const T& value) const { return value; }
+};
+
+template<class Pair>
+struct _Select1st {
+	const typename Pair::first_type& operator()(const Pair& value) const { return value.first; }
+};
+
+/* tag for ranges the caller guarantees to be sorted by the container's
+	comparator and free of duplicates, e.g. ft::map<K, V> m(ft::sorted_unique, first, last); */
+struct sorted_unique_t {};
+const sorted_unique_t sorted_unique = sorted_unique_t();
+
+/* picks the node constructor that forwards its arguments to the value, see _Rb_tree::emplace */
+struct _emplace_tag {};
+
+/* a node carries links, color and value, plus whatever its tree policy keeps in Data
+	(nothing by default, see tree_policy.hpp); ordering is the tree's business.
+	Nodes are at least pointer aligned, so the color lives in the low bit of the parent link. */
+template<class T, class Data = ft::tree_plain::node_data<T> >
+class node : public Data {
 public:
 	typedef T			value_type;
-	typedef Compare		value_compare;
-	node*				parent;
+	typedef Data		data_type;
 	node* 				child[2];
 
 private:
+	size_t				_parent_color;
 	value_type			_value;
-	value_compare		_comp;
-	int					_color;
+
+	node& operator=(const node& other);
 
 public:
-	node(const value_type& value = value_type(), const value_compare& comp = value_compare()) : parent(), child(), _value(value), _comp(comp), _color(RED) {}
-	node(const node& other) : parent(), child(), _value(other._value), _comp(other._comp), _color(other.getColor()) {}
+	node(const value_type& value = value_type()) : child(), _parent_color(RED), _value(value) {}
+	node(const node& other) : Data(other), child(), _parent_color(other.getColor()), _value(other._value) {}
+	/* builds a pair-like value straight inside the node, see _Rb_tree::try_insert */
+	template<class First, class Second>
+	node(const First& first, const Second& second) : child(), _parent_color(RED), _value(first, second) {}
+#if __cplusplus >= 201103L
+	template<class... Args>
+	node(_emplace_tag, Args&&... args) : child(), _parent_color(RED), _value(ft::forward<Args>(args)...) {}
+#endif
 	~node() {}
 
-	value_compare value_comp() const	{ return _comp; }
-	const int& getColor() const 		{ return _color; }
-	void changeColor() 					{ _color = !_color; }
-	void changeColor(int color) 		{ _color = color; }
+	/* the tree header is never constructed, only its links are set up */
+	void resetLinks()					{ child[ LEFT ] = NULL; child[ RIGHT ] = NULL; _parent_color = BLACK; }
 
-	node& operator=(const node& other) {
-		if (this == &other)
-			return *this;
-		_value(other._value);
-		return *this;
-	}
+	node* getParent() const				{ return reinterpret_cast<node*>(_parent_color & ~size_t(1)); }
+	void setParent(node* parent)		{ _parent_color = reinterpret_cast<size_t>(parent) | (_parent_color & 1); }
+	int getColor() const 				{ return static_cast<int>(_parent_color & 1); }
+	void changeColor() 					{ _parent_color ^= 1; }
+	void changeColor(int color) 		{ _parent_color = (_parent_color & ~size_t(1)) | static_cast<size_t>(color); }
 
 	value_type&	operator*() { return _value; }
-	
-	friend bool operator==(const node& lhs, const node& rhs) { return (!(lhs < rhs) && !(rhs < lhs)); }
-	friend bool operator!=(const node &lhs, const node &rhs) { return (!(lhs == rhs)); }
-	friend bool operator<(const node &lhs, const node &rhs) { return (lhs.value_comp()(lhs._value, rhs._value)); }
-	friend bool operator>=(const node &lhs, const node &rhs) { return (!(lhs < rhs)); }
-	friend bool operator>(const node &lhs, const node &rhs) { return (lhs.value_comp()(rhs._value, lhs._value)); }
-	friend bool operator<=(const node &lhs, const node &rhs) { return (!(lhs > rhs)); }
+
+	/* recomputes the policy data from the children, which must be up to date */
+	void update()						{ Data::update(child[ LEFT ], child[ RIGHT ], _value); }
+	void copyData(const node& other)	{ static_cast<Data&>(*this) = other; }
+};
+
+
+/* the key and mapped value of a map node handle, a set handle only has value() */
+template<class Handle, class Value>
+struct _node_handle_keys {};
+
+template<class Handle, class Key, class Mapped>
+struct _node_handle_keys<Handle, ft::pair<const Key, Mapped> > {
+	const Key& key() const		{ return static_cast<const Handle*>(this)->value().first; }
+	Mapped& mapped() const		{ return static_cast<const Handle*>(this)->value().second; }
+};
+
+template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Policy>
+class _Rb_tree;
+
+/* owns a node taken out of a tree by extract(), to be inserted into another
+	tree of the same type. The handle holds the pool of the tree the node came
+	from (see node_pool), so the node outlives that tree. With equal allocators
+	insert() shares the two pools and links the node as it is, nothing is
+	copied or allocated. Destroying a non-empty handle destroys the node and
+	gives it back to the pool. The key of a map node stays const.
+	Handles are move-only; in C++98 copying one transfers the node, as with std::auto_ptr. */
+template<class Node, class Alloc>
+class node_handle : public _node_handle_keys<node_handle<Node, Alloc>, typename Node::value_type> {
+	public:
+		typedef typename Node::value_type	value_type;
+
+	private:
+		template<class, class, class, class, class, class>
+		friend class _Rb_tree;
+
+		typedef ft::node_pool<Node, Alloc>	_pool_type;
+
+		_pool_type	_pool;
+		Node*		_node;
+
+		node_handle(Node* n, _pool_type& pool) : _pool(pool), _node(n) { _pool.share(pool); }
+
+		void _reset() {
+			if (_node) {
+				_pool.allocator().destroy(_node);
+				_pool.deallocate(_node);
+				_node = NULL;
+			}
+			_pool.release();
+		}
+
+	public:
+		node_handle() : _pool(), _node() {}
+		~node_handle() { _reset(); }
+
+#if __cplusplus >= 201103L
+		node_handle(node_handle&& other) : _pool(other._pool), _node() { swap(other); }
+
+		node_handle& operator=(node_handle&& other) {
+			if (this != &other) {
+				_reset();
+				swap(other);
+			}
+			return *this;
+		}
+
+		node_handle(const node_handle&) = delete;
+		node_handle& operator=(const node_handle&) = delete;
+
+		explicit operator bool() const		{ return _node != NULL; }
+#else
+		node_handle(const node_handle& other) : _pool(other._pool), _node() { swap(const_cast<node_handle&>(other)); }
+
+		node_handle& operator=(const node_handle& other) {
+			if (this != &other) {
+				_reset();
+				swap(const_cast<node_handle&>(other));
+			}
+			return *this;
+		}
+#endif
+
+		bool empty() const					{ return _node == NULL; }
+		value_type& value() const			{ return **_node; }
+
+		void swap(node_handle& other) {
+			_pool.swap(other._pool);
+			std::swap(_node, other._node);
+		}
 };
 
+/* what insert(node_type) of map and set returns: on a clash the node is handed back in node */
+template<class Iterator, class NodeHandle>
+struct node_insert_return {
+	Iterator	position;
+	bool		inserted;
+	NodeHandle	node;
+};
 
 
-template<class T, class Compare = std::less<T>, class Alloc = std::allocator<T> >
-class _Rb_tree {
+/* holds the comparator of the tree, a class type is kept as an empty base
+	so that a stateless comparator (std::less, ...) costs no space at all */
+template<class Compare, bool = ft::is_class<Compare>::value>
+class _Rb_tree_compare : private Compare {
+	protected:
+		_Rb_tree_compare(const Compare& comp) : Compare(comp) {}
+		const Compare& _tree_comp() const	{ return *this; }
+		void _swapCompare(_Rb_tree_compare& other) { std::swap(static_cast<Compare&>(*this), static_cast<Compare&>(other)); }
+};
+
+template<class Compare>
+class _Rb_tree_compare<Compare, false> {
+	private:
+		Compare _comp;
+	protected:
+		_Rb_tree_compare(const Compare& comp) : _comp(comp) {}
+		const Compare& _tree_comp() const	{ return _comp; }
+		void _swapCompare(_Rb_tree_compare& other) { std::swap(_comp, other._comp); }
+};
+
+
+
+/* Value is what the nodes hold, Key what the tree is ordered by:
+	set uses _Rb_tree<Key, Key, _Identity<Key> >, map _Rb_tree<Key, pair<const Key, T>, _Select1st<...> >.
+	Every lookup takes a key only, so no value_type is ever built to search.
+	Policy decides what else the nodes keep up to date, see tree_policy.hpp. */
+template<class Key, class Value = Key, class KeyOfValue = ft::_Identity<Value>, class Compare = std::less<Key>, class Alloc = std::allocator<Value>, class Policy = ft::tree_plain>
+class _Rb_tree : private _Rb_tree_compare<Compare> {
 	public:
-		typedef T															value_type;
-		typedef Compare														value_compare;
+		typedef Key															key_type;
+		typedef Value														value_type;
+		typedef Compare														key_compare;
 		typedef size_t														size_type;
-		typedef ft::node<value_type, value_compare>							node;
+		typedef Policy														tree_policy;
+		typedef ft::node<value_type, typename Policy::template node_data<value_type> >	node;
 		typedef tree_iterator< node, value_type*>							iterator;
 		typedef tree_iterator< node, const value_type*>						const_iterator;
 		typedef typename Alloc::template rebind<node>::other				allocator_type;
+		typedef ft::node_pool<node, allocator_type>							node_pool;
+		typedef ft::node_handle<node, allocator_type>						node_handle;
 		typedef typename ft::iterator_traits<iterator>::difference_type		difference_type;
 
 	private:
+		using _Rb_tree_compare<Compare>::_tree_comp;
+
+		/* _lastNode is the header of the tree: end() iterators point to it,
+			its parent is the root, its LEFT/RIGHT children are the leftmost and
+			rightmost nodes, which keeps begin() and --end() O(1).
+			The node allocator lives in _node_pool, which keeps it as an empty base. */
 		node*				_root;
 		node*				_lastNode;
 		size_type			_size;
-		value_compare		_tree_comp;
-		allocator_type		_tree_alloc;
+		node_pool			_node_pool;
 
 	public:
-		explicit _Rb_tree(const value_compare& comp = value_compare(), const allocator_type& alloc = allocator_type()) : _root(), _size(), _tree_comp(comp), _tree_alloc(alloc) { 
-			_lastNode = _tree_alloc.allocate(1);
+		explicit _Rb_tree(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _Rb_tree_compare<Compare>(comp), _root(), _size(), _node_pool(alloc) { 
+			_lastNode = _node_pool.allocator().allocate(1);
+			_lastNode->resetLinks();
 		}
 
-		_Rb_tree(const _Rb_tree& other) : _root(), _size(), _tree_comp(other._tree_comp), _tree_alloc(other._tree_alloc) {
-			_lastNode = _tree_alloc.allocate(1);
-			*this = other;
+		_Rb_tree(const _Rb_tree& other) : _Rb_tree_compare<Compare>(other._tree_comp()), _root(), _size(), _node_pool(other._node_pool) {
+			_lastNode = _node_pool.allocator().allocate(1);
+			_lastNode->resetLinks();
+			try {
+				*this = other;
+			}
+			catch (...) {
+				_node_pool.allocator().deallocate(_lastNode, 1);
+				throw ;
+			}
 		}
 
+#if __cplusplus >= 201103L
+		/* takes the nodes and the allocator over, other keeps a header of its own and is
+			left empty. That header is allocated, so unlike the vector's this move may throw. */
+		_Rb_tree(_Rb_tree&& other) : _Rb_tree_compare<Compare>(other._tree_comp()), _root(), _size(), _node_pool(other._node_pool) {
+			_lastNode = _node_pool.allocator().allocate(1);
+			_lastNode->resetLinks();
+			_swapContents(other);
+		}
+#endif
+
 		~_Rb_tree() {
 			if (_root)
 				_deleteTreeFrom(_root);
-			_tree_alloc.deallocate(_lastNode, 1);
+			_node_pool.allocator().deallocate(_lastNode, 1);
 		}
 
 		_Rb_tree& operator=(const _Rb_tree& other) {
@@ -108,25 +280,26 @@ class _Rb_tree {
 				return *this;
 			if (_root != NULL)
 				_deleteTreeFrom(_root);
-			_root = _copyTreeFrom(other.root());
-			_lastNode->parent = _root;
-			_size = other.size();
+			_root = NULL;
+			_size = 0;
+			_lastNode->resetLinks();
+			_node_pool.reserve(other.size());
+			_setRoot(_copyTreeFrom(other.root()), other.size());
 			return *this;
 		}
 
-		iterator begin() {
-			node* _first = _root;
-			while (_first && _first->child[ LEFT ])
-				_first = _first->child[ LEFT ];
-			return iterator(_first, _lastNode);
+#if __cplusplus >= 201103L
+		_Rb_tree& operator=(_Rb_tree&& other) {
+			if (this == &other)
+				return *this;
+			clear();
+			_swapContents(other);
+			return *this;
 		}
+#endif
 
-		const_iterator begin() const {
-			node* _first = _root;
-			while (_first && _first->child[ LEFT ])
-				_first = _first->child[ LEFT ];
-			return const_iterator(_first, _lastNode);
-		}
+		iterator begin()			{ return iterator(_leftmost(), _lastNode); }
+		const_iterator begin() const	{ return const_iterator(_leftmost(), _lastNode); }
 
 		iterator end()				{ return iterator(NULL, _lastNode); }
 		const_iterator end() const	{ return const_iterator(NULL, _lastNode); }
@@ -137,25 +310,69 @@ class _Rb_tree {
 		void clear() {
 			_deleteTreeFrom(root());
 			_root = NULL;
-			_lastNode->parent = NULL;
+			_lastNode->resetLinks();
 			_size = 0;
 		}
 
 		ft::pair<iterator, bool> insert(const value_type& value) {
-			iterator it = find(value);
-			if (it == end())
-				return ft::pair<iterator, bool>(_insertRoot(value), true);
-			if (!value_comp()(*it, value) && !value_comp()(value, *it))
-				return ft::pair<iterator, bool>(it, false);
-			_size++;
-			node* n = _insertNew(it.base(), value);
-			_insertFixUp(n);
-			return ft::pair<iterator, bool>(iterator(n, _lastNode), true);
+			node*	parent;
+			int		dir;
+			node*	n = _findLink(_root, _keyOf(value), parent, dir);
+			if (n)
+				return ft::pair<iterator, bool>(iterator(n, _lastNode), false);
+			return ft::pair<iterator, bool>(iterator(_link(_createNode(value), parent, dir), _lastNode), true);
 		}
 
-		size_type erase(const value_type& value) { 
-			iterator it = find(value);
-			if (it == end() || value_comp()(*it, value) || value_comp()(value, *it))
+		/* inserts value_type(key, arg) unless key is already there, in a single descent.
+			The value is built in the node only on a miss, an existing entry is left untouched. */
+#if __cplusplus >= 201103L
+		template<class K, class Arg>
+		ft::pair<iterator, bool> try_insert(K&& key, Arg&& arg) {
+			node*	parent;
+			int		dir;
+			node*	n = _findLink(_root, key, parent, dir);
+			if (n)
+				return ft::pair<iterator, bool>(iterator(n, _lastNode), false);
+			return ft::pair<iterator, bool>(iterator(_link(_emplaceNode(ft::forward<K>(key), ft::forward<Arg>(arg)), parent, dir), _lastNode), true);
+		}
+#else
+		template<class Arg>
+		ft::pair<iterator, bool> try_insert(const key_type& key, const Arg& arg) {
+			node*	parent;
+			int		dir;
+			node*	n = _findLink(_root, key, parent, dir);
+			if (n)
+				return ft::pair<iterator, bool>(iterator(n, _lastNode), false);
+			return ft::pair<iterator, bool>(iterator(_link(_createNode(key, arg), parent, dir), _lastNode), true);
+		}
+#endif
+
+		/* try_insert of value_type(key, mapped_type()) for pair values, as map::operator[] does:
+			the mapped value is only default-constructed, in the node, on a miss */
+#if __cplusplus >= 201103L
+		template<class K>
+		ft::pair<iterator, bool> try_insert_key(K&& key) {
+			node*	parent;
+			int		dir;
+			node*	n = _findLink(_root, key, parent, dir);
+			if (n)
+				return ft::pair<iterator, bool>(iterator(n, _lastNode), false);
+			return ft::pair<iterator, bool>(iterator(_link(_emplaceNode(ft::forward<K>(key), typename value_type::second_type()), parent, dir), _lastNode), true);
+		}
+#else
+		ft::pair<iterator, bool> try_insert_key(const key_type& key) {
+			node*	parent;
+			int		dir;
+			node*	n = _findLink(_root, key, parent, dir);
+			if (n)
+				return ft::pair<iterator, bool>(iterator(n, _lastNode), false);
+			return ft::pair<iterator, bool>(iterator(_link(_createNode(key, typename value_type::second_type()), parent, dir), _lastNode), true);
+		}
+#endif
+
+		size_type erase(const key_type& key) { 
+			iterator it = find(key);
+			if (it == end())
 				return 0;
 			erase(it);
 			return 1;
@@ -163,63 +380,231 @@ class _Rb_tree {
 
 		iterator erase(const_iterator it) {
 			node* _ptr = it.base();
-			_size--;
-			if (_ptr == _root && !_size) {
-				_tree_alloc.destroy(_ptr);
-				_tree_alloc.deallocate(_ptr, 1);
-				_root = NULL;
-				_lastNode->parent = NULL;
-				return end();
-			}
 			node* next = (++it).base();
-			if (_isInnerNode(_ptr)) 
-				_swapNodes(_ptr, next);
-			_deleteFixUp(_ptr);
-			_tree_alloc.destroy(_ptr);
-			_tree_alloc.deallocate(_ptr, 1);
+			_unlink(_ptr, next);
+			_dropNode(_ptr);
+			if (empty())
+				_node_pool.release();
 			return iterator(next, _lastNode);
 		}
 
-		iterator insert(const_iterator hint, const value_type& value) {
-			if (begin() == end()) // if empty tree
-				return _insertRoot(value);
-			if (hint == end()) {
-				if (value_comp()(*(--end()), value)) {// if last element is less than value -> insert in last position
-					node* n = _insertNew((--end()).base(), value);
-					_insertFixUp(n);
-					++_size;
-					return iterator(n, _lastNode);
+		/* unlinks the node at pos and hands it over as it is, see node_handle.
+			Nothing is allocated or copied. The tree keeps its pool even once
+			emptied, to recycle the nodes it shares with the handle's next tree. */
+		node_handle extract(const_iterator pos) {
+			node* n = pos.base();
+			_unlink(n, (++pos).base());
+			return node_handle(n, _node_pool);
+		}
+
+		node_handle extract(const key_type& key) {
+			node* n = _find(key);
+			if (!n)
+				return node_handle();
+			return extract(const_iterator(n, _lastNode));
+		}
+
+		/* links the handle's node in and leaves nh empty, unless its key is already
+			there: then nh keeps it and the clashing entry is returned */
+		ft::pair<iterator, bool> insert(node_handle& nh) {
+			if (nh.empty())
+				return ft::pair<iterator, bool>(end(), false);
+			node*	parent;
+			int		dir;
+			node*	n = _findLink(_root, _key(nh._node), parent, dir);
+			if (n)
+				return ft::pair<iterator, bool>(iterator(n, _lastNode), false);
+			return ft::pair<iterator, bool>(iterator(_adoptNode(nh, parent, dir), _lastNode), true);
+		}
+
+		iterator insert(const_iterator hint, node_handle& nh) {
+			if (nh.empty())
+				return end();
+			node*	parent;
+			int		dir;
+			node*	n = _hintLink(hint, _key(nh._node), parent, dir);
+			if (n)
+				return iterator(n, _lastNode);
+			return iterator(_adoptNode(nh, parent, dir), _lastNode);
+		}
+
+		/* takes every entry of other whose key is not here yet, the others stay in other.
+			Nodes are relinked as they are, nothing is allocated or copied: the two
+			pools are shared (see node_pool), an empty tree trades pools with other.
+			When other is at least as large as this tree, both are walked in order
+			and rebuilt balanced, in O(size() + other.size()); a smaller other is
+			linked in entry by entry, which beats walking a large tree whose nodes
+			are scattered in memory. Emptied, other keeps sharing the pool, so it
+			goes on recycling the nodes this tree frees. With unequal allocators
+			the entries are copied instead.
+			Both trees must order keys alike, as they do with a stateless comparator. */
+		void merge(_Rb_tree& other) {
+			if (this == &other || other.empty())
+				return ;
+			if (get_allocator() != other.get_allocator()) {
+				for (const_iterator it = other.begin(); it != other.end(); ) {
+					if (insert(*it).second)
+						it = other.erase(it);
+					else
+						++it;
 				}
-				else
-					return insert(value).first;
-			}
-			if (*hint == value) // if hint has the same key as value -> do nothing
-				return iterator(hint.base(), hint.getLastNode());
-			if (hint == begin() && value_comp()(value, *hint)) { // if value less than 1st element -> insert in first position.
-				node* n = _insertNew((begin()).base(), value);
-				_insertFixUp(n);
-				++_size;
+				return ;
+			}
+			if (empty()) {
+				std::swap(_root, other._root);
+				std::swap(_lastNode, other._lastNode);
+				std::swap(_size, other._size);
+				_node_pool.swap(other._node_pool);
+				return ;
+			}
+			_node_pool.share(other._node_pool);
+			if (other.size() < size())
+				_mergeByInsert(other);
+			else
+				_mergeByRebuild(other);
+		}
+
+		/* moves every element not less than key into right, which is emptied first.
+			The tree is cut along one root-to-leaf path, by joins of subtrees whose
+			black heights add up to O(log n), and right takes the upper part as it
+			is, sharing this tree's pool: nothing is allocated or copied. Unless
+			the policy counts subtree sizes, the size of the smaller part, of k
+			elements, is counted by walking both ways from the cut in step, in
+			O(k); with ft::tree_order_statistics a split is O(log n) all along.
+			With unequal allocators the upper part is copied instead. */
+		void split(const key_type& key, _Rb_tree& right) {
+			if (this == &right)
+				return ;
+			right.clear();
+			if (empty())
+				return ;
+			if (get_allocator() != right.get_allocator()) {
+				right.insert_range(ft::sorted_unique, lower_bound(key), end());
+				while (!empty() && !_tree_comp()(_key(_rightmost()), key))
+					erase(const_iterator(_rightmost(), _lastNode));
+				return ;
+			}
+			size_type	total = size();
+			size_type	below = _countBelow(key, typename Policy::counted());
+			if (below == total)
+				return ;
+			if (!below) {
+				right.merge(*this);
+				return ;
+			}
+			right._node_pool.share(_node_pool);
+			node*		l;
+			node*		r;
+			int			lbh;
+			int			rbh;
+			_splitSubtree(_root, _blackHeight(_root), key, l, lbh, r, rbh);
+			_setRoot(l, below);
+			right._setRoot(r, total - below);
+		}
+
+		/* takes over every element of other, whose keys must all compare greater, or
+			all less, than this tree's: the two are joined around the node of other
+			closest to this tree, in O(log n), and the pools shared; nothing is
+			allocated or copied. Overlapping ranges, or unequal allocators, fall back to merge(). */
+		void join(_Rb_tree& other) {
+			if (this == &other || other.empty())
+				return ;
+			bool after = !empty() && _tree_comp()(_key(_rightmost()), _key(other._leftmost()));
+			bool before = !empty() && _tree_comp()(_key(other._rightmost()), _key(_leftmost()));
+			if ((!after && !before) || get_allocator() != other.get_allocator()) {
+				merge(other);
+				return ;
+			}
+			size_type	total = size() + other.size();
+			_node_pool.share(other._node_pool);
+			node*		mid = after ? other._leftmost() : other._rightmost();
+			other._unlink(mid, after ? _successor(mid) : NULL);
+			node*		l = after ? _root : other._root;
+			node*		r = after ? other._root : _root;
+			int			bh;
+			node*		root = _join(l, _blackHeight(l), mid, r, _blackHeight(r), bh);
+			other._root = NULL;
+			other._size = 0;
+			other._lastNode->resetLinks();
+			_setRoot(root, total);
+		}
+
+		/* an empty tree filled from a sorted duplicate-free forward range is built
+			directly, in linear time; anything else is inserted element by element
+			with an end() hint, which appends a sorted tail without searching */
+		template<class InputIterator>
+		void insert_range(InputIterator first, InputIterator last) {
+			_insertRange(first, last, ft::is_forward_iterator<InputIterator>());
+		}
+
+		/* the caller guarantees [first, last) to be sorted and unique */
+		template<class ForwardIterator>
+		void insert_range(ft::sorted_unique_t, ForwardIterator first, ForwardIterator last) {
+			if (!empty())
+				return _insertRange(first, last, ft::false_type());
+			_buildSorted(first, ft::distance(first, last));
+		}
+
+		iterator insert(const_iterator hint, const value_type& value) {
+			node*	parent;
+			int		dir;
+			node*	n = _hintLink(hint, _keyOf(value), parent, dir);
+			if (n)
+				return iterator(n, _lastNode);
+			return iterator(_link(_createNode(value), parent, dir), _lastNode);
+		}
+
+#if __cplusplus >= 201103L
+		ft::pair<iterator, bool> insert(value_type&& value) {
+			node*	parent;
+			int		dir;
+			node*	n = _findLink(_root, _keyOf(value), parent, dir);
+			if (n)
+				return ft::pair<iterator, bool>(iterator(n, _lastNode), false);
+			return ft::pair<iterator, bool>(iterator(_link(_emplaceNode(ft::move(value)), parent, dir), _lastNode), true);
+		}
+
+		iterator insert(const_iterator hint, value_type&& value) {
+			node*	parent;
+			int		dir;
+			node*	n = _hintLink(hint, _keyOf(value), parent, dir);
+			if (n)
 				return iterator(n, _lastNode);
+			return iterator(_link(_emplaceNode(ft::move(value)), parent, dir), _lastNode);
+		}
+
+		/* the key is only known once the value exists: the node is built first
+			and given back if its key turns out to be there already */
+		template<class... Args>
+		ft::pair<iterator, bool> emplace(Args&&... args) {
+			node*	built = _emplaceNode(ft::forward<Args>(args)...);
+			node*	parent;
+			int		dir;
+			node*	n = _findLink(_root, _key(built), parent, dir);
+			if (n) {
+				_dropNode(built);
+				return ft::pair<iterator, bool>(iterator(n, _lastNode), false);
 			}
-			
-			/* hint points to node comparing more than value,
-				hint's inorder predecessor points to node comparing lower than value,
-				search for insert position from hint's pred ptr, then insert. */
-			if (value_comp()(value, *hint) && value_comp()(*(--hint), value)) {
-				node* n = _insertNew(_findInSubtree(hint.base(), value), value);
-				_insertFixUp(n);
-				++_size;
+			return ft::pair<iterator, bool>(iterator(_link(built, parent, dir), _lastNode), true);
+		}
+
+		template<class... Args>
+		iterator emplace_hint(const_iterator hint, Args&&... args) {
+			node*	built = _emplaceNode(ft::forward<Args>(args)...);
+			node*	parent;
+			int		dir;
+			node*	n = _hintLink(hint, _key(built), parent, dir);
+			if (n) {
+				_dropNode(built);
 				return iterator(n, _lastNode);
 			}
-			return insert(value).first;
+			return iterator(_link(built, parent, dir), _lastNode);
 		}
+#endif
 
 		void swap(_Rb_tree& other) {
-			if (this->get_allocator() == other.get_allocator()) {
-				std::swap(_root, other._root);
-				std::swap(_lastNode, other._lastNode);
-				std::swap(_size, other._size);
-			}
+			if (this->get_allocator() == other.get_allocator())
+				_swapContents(other);
 			else {
 				_Rb_tree tmp = *this;
 				*this = other;
@@ -228,107 +613,734 @@ class _Rb_tree {
 		}
 
 		node* root(void) const								{ return _root; }
-		value_compare value_comp(void) const				{ return _tree_comp; }
-		allocator_type get_allocator(void) const			{ return _tree_alloc; }
-		iterator find(const value_type& value)				{ node *tmp = _findInSubtree(_root, value); return iterator(tmp, _lastNode); }
-		const_iterator find(const value_type& value) const	{ node *tmp = _findInSubtree(_root, value); return const_iterator(tmp, _lastNode); }
+		key_compare key_comp(void) const					{ return _tree_comp(); }
+		allocator_type get_allocator(void) const			{ return _node_pool.get_allocator(); }
+		iterator find(const key_type& key)					{ return iterator(_find(key), _lastNode); }
+		const_iterator find(const key_type& key) const		{ return const_iterator(_find(key), _lastNode); }
+		size_type count(const key_type& key) const			{ return _find(key) ? 1 : 0; }
+
+		iterator lower_bound(const key_type& key)				{ return iterator(_lowerBound(_root, NULL, key), _lastNode); }
+		const_iterator lower_bound(const key_type& key) const	{ return const_iterator(_lowerBound(_root, NULL, key), _lastNode); }
+		iterator upper_bound(const key_type& key)				{ return iterator(_upperBound(_root, NULL, key), _lastNode); }
+		const_iterator upper_bound(const key_type& key) const	{ return const_iterator(_upperBound(_root, NULL, key), _lastNode); }
+
+		ft::pair<iterator, iterator> equal_range(const key_type& key) {
+			ft::pair<node*, node*> range = _equalRange(key);
+			return ft::pair<iterator, iterator>(iterator(range.first, _lastNode), iterator(range.second, _lastNode));
+		}
+
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+			ft::pair<node*, node*> range = _equalRange(key);
+			return ft::pair<const_iterator, const_iterator>(const_iterator(range.first, _lastNode), const_iterator(range.second, _lastNode));
+		}
+
+		/* order statistics, in O(log n): only trees whose policy counts the nodes
+			of every subtree (ft::tree_order_statistics) have them, on any other
+			tree they do not compile. nth(k) is the element at index k, end() past the last. */
+		iterator nth(size_type k)					{ return iterator(_nth(k), _lastNode); }
+		const_iterator nth(size_type k) const		{ return const_iterator(_nth(k), _lastNode); }
+
+		/* the number of elements less than key, that is the index of lower_bound(key) */
+		size_type rank(const key_type& key) const {
+			size_type	rank = 0;
+			node*		n = _root;
+			while (n) {
+				if (_tree_comp()(_key(n), key)) {
+					rank += _subtreeSize(n->child[ LEFT ]) + 1;
+					n = n->child[ RIGHT ];
+				} else
+					n = n->child[ LEFT ];
+			}
+			return rank;
+		}
+
+		difference_type distance(const_iterator first, const_iterator last) const {
+			return static_cast<difference_type>(_index(last.base())) - static_cast<difference_type>(_index(first.base()));
+		}
+
+		/* the monoid of an aggregating policy (ft::tree_aggregate) folded over the elements
+			whose keys lie in [lo, hi), in key order, in O(log n): the first node in range
+			met from the root splits the range, below it each side adds whole subtrees.
+			Like nth(), it does not compile on a tree whose policy keeps no summary. */
+		typename Policy::summary_type aggregate(const key_type& lo, const key_type& hi) const {
+			typedef typename Policy::monoid_type	monoid;
+			node*	top = _root;
+			while (top) {
+				if (_tree_comp()(_key(top), lo))
+					top = top->child[ RIGHT ];
+				else if (!_tree_comp()(_key(top), hi))
+					top = top->child[ LEFT ];
+				else
+					break ;
+			}
+			if (!top)
+				return monoid::identity();
+			typename Policy::summary_type	left = monoid::identity();
+			typename Policy::summary_type	right = monoid::identity();
+			for (node* n = top->child[ LEFT ]; n; ) {
+				if (_tree_comp()(_key(n), lo))
+					n = n->child[ RIGHT ];
+				else {
+					left = monoid::combine(monoid::combine(monoid::of(**n), _summary(n->child[ RIGHT ])), left);
+					n = n->child[ LEFT ];
+				}
+			}
+			for (node* n = top->child[ RIGHT ]; n; ) {
+				if (!_tree_comp()(_key(n), hi))
+					n = n->child[ LEFT ];
+				else {
+					right = monoid::combine(right, monoid::combine(_summary(n->child[ LEFT ]), monoid::of(**n)));
+					n = n->child[ RIGHT ];
+				}
+			}
+			return monoid::combine(monoid::combine(left, monoid::of(**top)), right);
+		}
+
+		/* the value at pos was changed in place: the policy data above it are brought up to date */
+		void refresh(const_iterator pos)				{ _updateUp(pos.base()); }
 
 	private:
 
+		/* trades everything, the node allocators go along with their nodes */
+		void _swapContents(_Rb_tree& other) {
+			std::swap(_root, other._root);
+			std::swap(_lastNode, other._lastNode);
+			std::swap(_size, other._size);
+			_node_pool.swap(other._node_pool);
+			this->_swapCompare(other);
+		}
+
+		/* brings the policy data of n and of every node above it up to date,
+			the nodes of a tree without augmentation are not even visited */
+		void _updateUp(node* n)						{ _updateUp(n, typename Policy::augmented()); }
+		static void _updateUp(node*, ft::false_type)	{}
+
+		static void _updateUp(node* n, ft::true_type) {
+			for (; n; n = n->getParent())
+				n->update();
+		}
+
+		static size_type _subtreeSize(node* n)		{ return n ? n->subtree_size : 0; }
+
+		static typename Policy::summary_type _summary(node* n) {
+			return n ? n->summary : Policy::monoid_type::identity();
+		}
+
+		node* _nth(size_type k) const {
+			node* n = _root;
+			while (n) {
+				size_type	left = _subtreeSize(n->child[ LEFT ]);
+				if (k < left)
+					n = n->child[ LEFT ];
+				else if (k == left)
+					return n;
+				else {
+					k -= left + 1;
+					n = n->child[ RIGHT ];
+				}
+			}
+			return NULL;
+		}
+
+		/* the index of n in order, size() for end() */
+		size_type _index(node* n) const {
+			if (!n)
+				return _size;
+			size_type	index = _subtreeSize(n->child[ LEFT ]);
+			for (node* parent = n->getParent(); parent; n = parent, parent = n->getParent())
+				if (n == parent->child[ RIGHT ])
+					index += _subtreeSize(parent->child[ LEFT ]) + 1;
+			return index;
+		}
+
+		static const key_type& _keyOf(const value_type& value)	{ return KeyOfValue()(value); }
+		static const key_type& _key(node* n)					{ return KeyOfValue()(*(*n)); }
+		bool _equivalent(const key_type& lhs, const key_type& rhs) const { return !_tree_comp()(lhs, rhs) && !_tree_comp()(rhs, lhs); }
+
+		/* the node holding key, NULL if there is none */
+		node* _find(const key_type& key) const {
+			node* n = _root;
+			while (n) {
+				if (_tree_comp()(key, _key(n)))
+					n = n->child[ LEFT ];
+				else if (_tree_comp()(_key(n), key))
+					n = n->child[ RIGHT ];
+				else
+					return n;
+			}
+			return NULL;
+		}
+
+		/* first node not less than key in the subtree of n, best is the candidate found above it */
+		node* _lowerBound(node* n, node* best, const key_type& key) const {
+			while (n) {
+				if (!_tree_comp()(_key(n), key)) {
+					best = n;
+					n = n->child[ LEFT ];
+				} else
+					n = n->child[ RIGHT ];
+			}
+			return best;
+		}
+
+		/* first node greater than key in the subtree of n, best is the candidate found above it */
+		node* _upperBound(node* n, node* best, const key_type& key) const {
+			while (n) {
+				if (_tree_comp()(key, _key(n))) {
+					best = n;
+					n = n->child[ LEFT ];
+				} else
+					n = n->child[ RIGHT ];
+			}
+			return best;
+		}
+
+		/* one descent down to the first equal node, then the two bounds finish in its subtrees */
+		ft::pair<node*, node*> _equalRange(const key_type& key) const {
+			node* n = _root;
+			node* upper = NULL;
+			while (n) {
+				if (_tree_comp()(_key(n), key))
+					n = n->child[ RIGHT ];
+				else if (_tree_comp()(key, _key(n))) {
+					upper = n;
+					n = n->child[ LEFT ];
+				} else
+					return ft::pair<node*, node*>(_lowerBound(n->child[ LEFT ], n, key), _upperBound(n->child[ RIGHT ], upper, key));
+			}
+			return ft::pair<node*, node*>(upper, upper);
+		}
+
 		void _rotate(node* old_root, int dir) {
 			node* new_root = old_root->child[ !dir ];
 			if (!new_root)
 				return ;
 			if (old_root == root()) {
 				_root = new_root;
-				_lastNode->parent = _root;
+				_lastNode->setParent(_root);
 			} else
-				old_root->parent->child[ _makeSelfie(old_root) ] = new_root;
-			new_root->parent = old_root->parent;
-			old_root->parent = new_root;
+				old_root->getParent()->child[ _makeSelfie(old_root) ] = new_root;
+			new_root->setParent(old_root->getParent());
+			old_root->setParent(new_root);
 			old_root->child[ !dir ] = new_root->child[ dir ];
 			new_root->child[ dir ] = old_root;
 			if (old_root->child[ !dir ] != NULL)
-				old_root->child[ !dir ]->parent = old_root;
+				old_root->child[ !dir ]->setParent(old_root);
+			old_root->update();
+			new_root->update();
 		}
 
-		node* _findInSubtree(node* start, const value_type& value) const {
-			if (!start)
-				return NULL;
-			node* next;
-			while (value_comp()(*(*start), value) || value_comp()(value, *(*start))) {
-				if (value_comp()(*(*start), value))
-					next = start->child[ RIGHT ];
+		/* descends from start once: returns the node holding key, or NULL with
+			parent->child[dir] set to the empty link key belongs to (parent NULL for an empty tree) */
+		node* _findLink(node* start, const key_type& key, node*& parent, int& dir) const {
+			parent = NULL;
+			dir = LEFT;
+			for (node* n = start; n; n = n->child[ dir ]) {
+				if (_tree_comp()(key, _key(n)))
+					dir = LEFT;
+				else if (_tree_comp()(_key(n), key))
+					dir = RIGHT;
 				else
-					next = start->child[ LEFT ];
-				if (!next)
-					break ;
-				start = next;
+					return n;
+				parent = n;
 			}
-			return start;
+			return NULL;
 		}
 
+		/* _findLink with a hint: a key that belongs right before hint, or at either end,
+			is placed without a descent from the root */
+		node* _hintLink(const_iterator hint, const key_type& key, node*& parent, int& dir) {
+			parent = NULL;
+			dir = LEFT;
+			if (empty())
+				return NULL;
+			if (hint == end()) {
+				if (_tree_comp()(_key(_rightmost()), key)) { // if last element is less than key -> insert in last position
+					parent = _rightmost();
+					dir = RIGHT;
+					return NULL;
+				}
+				return _findLink(_root, key, parent, dir);
+			}
+			if (_equivalent(_key(hint.base()), key)) // if hint has the same key -> do nothing
+				return hint.base();
+			if (hint == begin() && _tree_comp()(key, _key(hint.base()))) { // if key less than 1st element -> insert in first position.
+				parent = _leftmost();
+				return NULL;
+			}
+
+			/* hint points to node comparing more than key,
+				hint's inorder predecessor points to node comparing lower than key,
+				search for insert position from hint's pred ptr. */
+			if (_tree_comp()(key, _key(hint.base())) && _tree_comp()(_key((--hint).base()), key))
+				return _findLink(hint.base(), key, parent, dir);
+			return _findLink(_root, key, parent, dir);
+		}
 
 		void _swapNodes(node* lhs, node* rhs) {
-			node* tmp[3] = { lhs->parent, lhs->child[ LEFT ], lhs->child[ RIGHT ] };
+			node* tmp[3] = { lhs->getParent(), lhs->child[ LEFT ], lhs->child[ RIGHT ] };
 			int node_id_lhs = -1;
 			int node_id_rhs = -1;
-			if (lhs->parent)
+			if (lhs->getParent())
 				node_id_lhs = _makeSelfie(lhs);
-			if (rhs->parent)
+			if (rhs->getParent())
 				node_id_rhs = _makeSelfie(rhs);
 
 			int lhs_color = lhs->getColor();
 			lhs->changeColor(rhs->getColor());
 			rhs->changeColor(lhs_color);
 
-			lhs->parent = (rhs->parent == lhs) ? rhs : rhs->parent;
+			lhs->setParent((rhs->getParent() == lhs) ? rhs : rhs->getParent());
 			lhs->child[ LEFT ] = rhs->child[ LEFT ];
 			lhs->child[ RIGHT ] = rhs->child[ RIGHT ];
 
-			rhs->parent = tmp[0];
+			rhs->setParent(tmp[0]);
 			rhs->child[ LEFT ] = (tmp[1] == rhs) ? lhs : tmp[1];
 			rhs->child[ RIGHT ] = (tmp[2] == rhs) ? lhs : tmp[2];
 
-			if (lhs->parent)
-				lhs->parent->child[ node_id_rhs ] = lhs;
+			if (lhs->getParent())
+				lhs->getParent()->child[ node_id_rhs ] = lhs;
 			if (lhs->child[ LEFT ])
-				lhs->child[ LEFT ]->parent = lhs;
+				lhs->child[ LEFT ]->setParent(lhs);
 			if (lhs->child[ RIGHT ])
-				lhs->child[ RIGHT ]->parent = lhs;
+				lhs->child[ RIGHT ]->setParent(lhs);
 
-			if (rhs->parent)
-				rhs->parent->child[ node_id_lhs ] = rhs;
+			if (rhs->getParent())
+				rhs->getParent()->child[ node_id_lhs ] = rhs;
 			if (rhs->child[ LEFT ])
-				rhs->child[ LEFT ]->parent = rhs;
+				rhs->child[ LEFT ]->setParent(rhs);
 			if (rhs->child[ RIGHT ])
-				rhs->child[ RIGHT ]->parent = rhs;
+				rhs->child[ RIGHT ]->setParent(rhs);
 
 			if (lhs == root()) {
 				_root = rhs;
-				_lastNode->parent = rhs;
+				_lastNode->setParent(rhs);
 			}
 		}
 
-		iterator _insertRoot(const value_type& value) {
-			node _value(value, _tree_comp);
-			_root = _tree_alloc.allocate(1);
-			_tree_alloc.construct(_root, _value);
-			_lastNode->parent = _root;
-			_root->changeColor();
-			_size++;
-			return iterator(_root, _lastNode);
+		template<class InputIterator>
+		void _insertRange(InputIterator first, InputIterator last, ft::false_type) {
+			for (; first != last; ++first)
+				insert(end(), *first);
+		}
+
+		template<class ForwardIterator>
+		void _insertRange(ForwardIterator first, ForwardIterator last, ft::true_type) {
+			if (!empty() || first == last)
+				return _insertRange(first, last, ft::false_type());
+			size_type		count = 1;
+			ForwardIterator	prev = first;
+			for (ForwardIterator it = first; ++it != last; prev = it, ++count)
+				if (!_tree_comp()(_keyOf(*prev), _keyOf(*it)))
+					return _insertRange(first, last, ft::false_type());
+			_buildSorted(first, count);
+		}
+
+		/* builds a perfectly balanced tree out of count sorted values into an empty tree,
+			with all node storage taken from a single slab.
+			Every level above depth floor(log2(count + 1)) is full, the nodes on that
+			last partial level are RED and all the others BLACK, so every path holds
+			the same number of BLACK nodes. */
+		template<class ForwardIterator>
+		void _buildSorted(ForwardIterator first, size_type count) {
+			if (!count)
+				return ;
+			_node_pool.reserve(count);
+			_setRoot(_buildSubtree(first, count, 0, _log2(count + 1), NULL), count);
+		}
+
+		template<class ForwardIterator>
+		node* _buildSubtree(ForwardIterator& first, size_type count, int depth, int red_depth, node* parent) {
+			if (!count)
+				return NULL;
+			size_type	left_count = (count - 1) / 2;
+			node*		left = _buildSubtree(first, left_count, depth + 1, red_depth, NULL);
+			node*		n = _createNode(*first);
+			++first;
+			n->setParent(parent);
+			n->child[ LEFT ] = left;
+			if (left)
+				left->setParent(n);
+			n->child[ RIGHT ] = _buildSubtree(first, count - 1 - left_count, depth + 1, red_depth, n);
+			if (depth != red_depth)
+				n->changeColor(BLACK);
+			n->update();
+			return n;
+		}
+
+		static int _log2(size_type n) {
+			int log = 0;
+			for (; n > 1; n >>= 1)
+				log++;
+			return log;
+		}
+
+		/* root becomes the root of this tree of count nodes, the header is set up around it */
+		void _setRoot(node* root, size_type count) {
+			_root = root;
+			_size = count;
+			_lastNode->resetLinks();
+			_lastNode->setParent(_root);
+			_leftmost() = _root;
+			_rightmost() = _root;
+			while (_leftmost() && _leftmost()->child[ LEFT ])
+				_leftmost() = _leftmost()->child[ LEFT ];
+			while (_rightmost() && _rightmost()->child[ RIGHT ])
+				_rightmost() = _rightmost()->child[ RIGHT ];
+		}
+
+		/* nodes are built in place in the pool storage, the value is copied exactly once */
+		node* _createNode(const value_type& value) {
+			node* newNode = _node_pool.allocate();
+			try {
+				::new (static_cast<void*>(newNode)) node(value);
+			}
+			catch (...) {
+				_node_pool.deallocate(newNode);
+				throw ;
+			}
+			return newNode;
+		}
+
+		template<class First, class Second>
+		node* _createNode(const First& first, const Second& second) {
+			node* newNode = _node_pool.allocate();
+			try {
+				::new (static_cast<void*>(newNode)) node(first, second);
+			}
+			catch (...) {
+				_node_pool.deallocate(newNode);
+				throw ;
+			}
+			return newNode;
+		}
+
+#if __cplusplus >= 201103L
+		/* the value is built from args straight in the node, an rvalue is moved in */
+		template<class... Args>
+		node* _emplaceNode(Args&&... args) {
+			node* newNode = _node_pool.allocate();
+			try {
+				::new (static_cast<void*>(newNode)) node(_emplace_tag(), ft::forward<Args>(args)...);
+			}
+			catch (...) {
+				_node_pool.deallocate(newNode);
+				throw ;
+			}
+			return newNode;
+		}
+#endif
+
+		/* destroys a node that is not linked (anymore) and gives its storage back to the pool */
+		void _dropNode(node* n) {
+			_node_pool.allocator().destroy(n);
+			_node_pool.deallocate(n);
 		}
 
-		node* _insertNew(node* parentNode, const value_type& value) {
-			node tmp(value, _tree_comp);
-			node* newNode = _tree_alloc.allocate(1);
-			_tree_alloc.construct(newNode, tmp);
-			newNode->parent = parentNode;
-			parentNode->child[ (*newNode < *parentNode) ? LEFT : RIGHT ] = newNode;
+		/* builds in storage a node holding the value of n, a node of another tree:
+			the value is moved out of n if that cannot throw, copied otherwise,
+			so a throw leaves n as it was */
+		static void _constructFrom(node* storage, node* n) {
+#if __cplusplus >= 201103L
+			if (_movesValues::value) {
+				::new (static_cast<void*>(storage)) node(_emplace_tag(), ft::move(**n));
+				return ;
+			}
+#endif
+			::new (static_cast<void*>(storage)) node(**n);
+		}
+
+		/* a node of this tree's pool built by _constructFrom */
+		node* _transplant(node* n) {
+			node* newNode = _node_pool.allocate();
+			try {
+				_constructFrom(newNode, n);
+			}
+			catch (...) {
+				_node_pool.deallocate(newNode);
+				throw ;
+			}
 			return newNode;
 		}
 
+		typedef ft::is_nothrow_move_constructible<value_type>	_movesValues;
+
+		/* takes n out of the tree and rebalances, next being its successor (NULL for the last node).
+			n is neither destroyed nor given back, it leaves with clean links, ready to be linked again. */
+		void _unlink(node* n, node* next) {
+			_size--;
+			if (n == _root && !_size) {
+				_root = NULL;
+				_lastNode->resetLinks();
+			} else {
+				if (n == _rightmost())
+					_rightmost() = (--const_iterator(n, _lastNode)).base();
+				if (n == _leftmost())
+					_leftmost() = next;
+				if (_isInnerNode(n)) {
+					_swapNodes(n, next);
+					_updateUp(n);
+				}
+				_deleteFixUp(n);
+				_updateUp(n->getParent());
+			}
+			n->child[ LEFT ] = NULL;
+			n->child[ RIGHT ] = NULL;
+			n->setParent(NULL);
+			n->changeColor(RED);
+		}
+
+		/* links the node of nh as it is, after sharing the pools. With another
+			allocator the node cannot stay: its value goes into a node of this
+			tree's pool, see _transplant. */
+		node* _adoptNode(node_handle& nh, node* parent, int dir) {
+			node* n = nh._node;
+			if (get_allocator() != nh._pool.get_allocator()) {
+				n = _transplant(nh._node);
+				nh._reset();
+			} else {
+				_node_pool.share(nh._pool);
+				nh._node = NULL;
+				nh._pool.release();
+			}
+			return _link(n, parent, dir);
+		}
+
+		/* every node of other whose key is not here is unlinked and linked in, one by one */
+		void _mergeByInsert(_Rb_tree& other) {
+			for (node* n = other._leftmost(); n; ) {
+				node*	next = _successor(n);
+				node*	parent;
+				int		dir;
+				if (!_findLink(_root, _key(n), parent, dir)) {
+					other._unlink(n, next);
+					_link(n, parent, dir);
+				}
+				n = next;
+			}
+		}
+
+		/* a merge of the two in-order sequences: every node goes on one of two lists,
+			the nodes kept by this tree and the clashing ones left to other, and each
+			tree is rebuilt from its list. The lists are threaded through child[LEFT],
+			which the in-order walk never reads again once it has passed a node. */
+		void _mergeByRebuild(_Rb_tree& other) {
+			node*		a = _leftmost();
+			node*		b = other._leftmost();
+			node*		merged = NULL;
+			node*		kept = NULL;
+			size_type	merged_count = 0;
+			size_type	kept_count = 0;
+			while (a || b) {
+				node* n;
+				if (!b || (a && _tree_comp()(_key(a), _key(b)))) {
+					n = a;
+					a = _successor(a);
+				} else {
+					n = b;
+					b = _successor(b);
+					if (a && !_tree_comp()(_key(n), _key(a))) {
+						n->child[ LEFT ] = kept;
+						kept = n;
+						kept_count++;
+						continue ;
+					}
+				}
+				n->child[ LEFT ] = merged;
+				merged = n;
+				merged_count++;
+			}
+			_relinkSorted(merged, merged_count);
+			other._relinkSorted(kept, kept_count);
+		}
+
+		/* BLACK nodes on a path from n down to a leaf, n included */
+		static int _blackHeight(node* n) {
+			int height = 0;
+			for (; n; n = n->child[ LEFT ])
+				height += (n->getColor() == BLACK);
+			return height;
+		}
+
+		/* joins the subtrees l and r, of black heights lbh and rbh, around the loose node
+			mid, every key of l being less than mid's and every key of r greater.
+			mid takes the place of the first BLACK node of black height min(lbh, rbh)
+			on the inner spine of the taller subtree, with the shorter one as its other
+			child, and is fixed up as an inserted RED node, in O(|lbh - rbh| + 1).
+			Returns the root, BLACK, and its black height in bh. _root is used as scratch. */
+		node* _join(node* l, int lbh, node* mid, node* r, int rbh, int& bh) {
+			if (l && l->getColor() == RED) {
+				l->changeColor(BLACK);
+				lbh++;
+			}
+			if (r && r->getColor() == RED) {
+				r->changeColor(BLACK);
+				rbh++;
+			}
+			if (l)
+				l->setParent(NULL);
+			if (r)
+				r->setParent(NULL);
+			if (lbh == rbh) {
+				_hang(mid, LEFT, l);
+				_hang(mid, RIGHT, r);
+				mid->setParent(NULL);
+				mid->changeColor(BLACK);
+				mid->update();
+				bh = lbh + 1;
+				return mid;
+			}
+			int		dir = (lbh > rbh) ? RIGHT : LEFT;
+			node*	tall = (dir == RIGHT) ? l : r;
+			node*	low = (dir == RIGHT) ? r : l;
+			int		target = std::min(lbh, rbh);
+			int		height = std::max(lbh, rbh);
+			node*	parent = NULL;
+			node*	n = tall;
+			while (n && !(n->getColor() == BLACK && height == target)) {
+				height -= (n->getColor() == BLACK);
+				parent = n;
+				n = n->child[ dir ];
+			}
+			_hang(mid, !dir, n);
+			_hang(mid, dir, low);
+			_hang(parent, dir, mid);
+			mid->changeColor(RED);
+			_root = tall;
+			_updateUp(mid);
+			_insertFixUp(mid);
+			if (low) {
+				// the fix-up leaves the shorter subtree untouched, it is counted from there up
+				bh = target;
+				for (node* up = low->getParent(); up; up = up->getParent())
+					bh += (up->getColor() == BLACK);
+			} else
+				bh = _blackHeight(_root);
+			return _root;
+		}
+
+		static void _hang(node* parent, int dir, node* n) {
+			parent->child[ dir ] = n;
+			if (n)
+				n->setParent(parent);
+		}
+
+		/* cuts the subtree t, of black height bh, into the keys less than key, l,
+			and the others, r: each node on the search path is joined to the part
+			its side of the path belongs to, together with its subtree on that side */
+		void _splitSubtree(node* t, int bh, const key_type& key, node*& l, int& lbh, node*& r, int& rbh) {
+			if (!t) {
+				l = NULL;
+				r = NULL;
+				lbh = 0;
+				rbh = 0;
+				return ;
+			}
+			node*	left = t->child[ LEFT ];
+			node*	right = t->child[ RIGHT ];
+			int		child_bh = bh - (t->getColor() == BLACK);
+			t->child[ LEFT ] = NULL;
+			t->child[ RIGHT ] = NULL;
+			if (_tree_comp()(_key(t), key)) {
+				node*	rest;
+				int		rest_bh;
+				_splitSubtree(right, child_bh, key, rest, rest_bh, r, rbh);
+				l = _join(left, child_bh, t, rest, rest_bh, lbh);
+			} else {
+				node*	rest;
+				int		rest_bh;
+				_splitSubtree(left, child_bh, key, l, lbh, rest, rest_bh);
+				r = _join(rest, rest_bh, t, right, child_bh, rbh);
+			}
+		}
+
+		/* the number of keys less than key: the rank when subtree sizes are counted,
+			otherwise the smaller side of lower_bound(key) is walked, both ways in step */
+		size_type _countBelow(const key_type& key, ft::true_type) const	{ return rank(key); }
+
+		size_type _countBelow(const key_type& key, ft::false_type) const {
+			size_type		count = 0;
+			const_iterator	up = lower_bound(key);
+			const_iterator	down = up;
+			for (; up != end() && down != begin(); ++count) {
+				++up;
+				--down;
+			}
+			return (up == end()) ? size() - count : count;
+		}
+
+		/* in-order successor through the links alone, NULL after the last node */
+		static node* _successor(node* n) {
+			if (n->child[ RIGHT ]) {
+				n = n->child[ RIGHT ];
+				while (n->child[ LEFT ])
+					n = n->child[ LEFT ];
+				return n;
+			}
+			node* parent = n->getParent();
+			while (parent && n == parent->child[ RIGHT ]) {
+				n = parent;
+				parent = n->getParent();
+			}
+			return parent;
+		}
+
+		/* rebuilds this tree, balanced like _buildSorted, out of count nodes listed
+			from the greatest down through child[LEFT] */
+		void _relinkSorted(node* last, size_type count)	{ _setRoot(_relinkList(last, count), count); }
+
+		/* the same, returning the root of the subtree, parentless and BLACK */
+		node* _relinkList(node* last, size_type count) {
+			node* first = NULL;
+			while (last) {
+				node* prev = last->child[ LEFT ];
+				last->child[ RIGHT ] = first;
+				first = last;
+				last = prev;
+			}
+			return _relinkSubtree(first, count, 0, _log2(count + 1), NULL);
+		}
+
+		/* _buildSubtree over existing nodes listed through child[RIGHT] */
+		node* _relinkSubtree(node*& first, size_type count, int depth, int red_depth, node* parent) {
+			if (!count)
+				return NULL;
+			size_type	left_count = (count - 1) / 2;
+			node*		left = _relinkSubtree(first, left_count, depth + 1, red_depth, NULL);
+			node*		n = first;
+			first = n->child[ RIGHT ];
+			n->setParent(parent);
+			n->child[ LEFT ] = left;
+			if (left)
+				left->setParent(n);
+			n->child[ RIGHT ] = _relinkSubtree(first, count - 1 - left_count, depth + 1, red_depth, n);
+			n->changeColor(depth == red_depth ? RED : BLACK);
+			n->update();
+			return n;
+		}
+
+		/* hangs the new node n on parent->child[dir] (or makes it the root), keeps
+			leftmost/rightmost and the size up to date and rebalances */
+		node* _link(node* n, node* parent, int dir) {
+			n->setParent(parent);
+			if (!parent) {
+				_root = n;
+				_lastNode->setParent(_root);
+				_leftmost() = n;
+				_rightmost() = n;
+			} else {
+				parent->child[ dir ] = n;
+				if (dir == LEFT && parent == _leftmost())
+					_leftmost() = n;
+				else if (dir == RIGHT && parent == _rightmost())
+					_rightmost() = n;
+			}
+			_size++;
+			_updateUp(n);
+			_insertFixUp(n);
+			return n;
+		}
+
 		void _insertFixUp(node* n) {
 			/* node is root -> change color from RED to BLACK */
 			if (n == _root) {
@@ -337,7 +1349,7 @@ class _Rb_tree {
 			}
 
 			/* parent of node is BLACK, tree is balanced -> return */
-			if (n->parent->getColor() == BLACK) {
+			if (n->getParent()->getColor() == BLACK) {
 				return ;
 			}
 
@@ -348,7 +1360,7 @@ class _Rb_tree {
 			};
 			int case_id = (_whatIsTheColor(_getUncle(n)) == BLACK);
 			if (case_id)
-				case_id += (_makeSelfie(n) == _makeSelfie(n->parent));
+				case_id += (_makeSelfie(n) == _makeSelfie(n->getParent()));
 			(this->*_insertFixUpList[ case_id ])(n);
 		}
 
@@ -366,8 +1378,8 @@ class _Rb_tree {
 		/* parent of node is RED, uncle of node is BLACK, node and parent of node do not share same node-id (LEFT or RIGHT),
 			_rotate Parent in opposite direction, then call case 5 with old-parent of node */
 		void _insertFixUp_4(node* n) {
-			node* tmp = n->parent;
-			_rotate(n->parent, _makeSelfie(n->parent));
+			node* tmp = n->getParent();
+			_rotate(n->getParent(), _makeSelfie(n->getParent()));
 			_insertFixUp(tmp);
 		}
 
@@ -411,8 +1423,8 @@ class _Rb_tree {
 				-> change color of child & remove node (rewrite parent and child's access) */
 			if (caseID == 2) {
 				_deleteFixUpCase(n);
-				if (n->parent)
-					n->parent->child[ _makeSelfie(n) ] = NULL;
+				if (n->getParent())
+					n->getParent()->child[ _makeSelfie(n) ] = NULL;
 			}
 			else // check recursive cases
 				(this->*_deleteFixUpList[ caseID ])(n);
@@ -437,19 +1449,19 @@ class _Rb_tree {
 		}
 
 		void _deleteFixUp_1(node* n) { 
-			n->parent->child[ _makeSelfie(n) ] = NULL;
+			n->getParent()->child[ _makeSelfie(n) ] = NULL;
 		}
 
 		void _deleteFixUp_2(node* child) { 
-			node* n = child->parent;
+			node* n = child->getParent();
 			child->changeColor();
-			child->parent = n->parent;
+			child->setParent(n->getParent());
 			if (n == root()) {
 				_root = child;
-				_lastNode->parent = _root;
+				_lastNode->setParent(_root);
 			} else
-				n->parent->child[ _makeSelfie(n) ] = child;
-			child->parent = n->parent;
+				n->getParent()->child[ _makeSelfie(n) ] = child;
+			child->setParent(n->getParent());
 		}
 
 		/* sibling of node is RED,
@@ -457,9 +1469,9 @@ class _Rb_tree {
 		_rotate parent of node in node's direction,
 		then check next case on same node */
 		void _deleteFixUpCase1(node* n) {
-			_getSibling(n)->changeColor(n->parent->getColor());
-			n->parent->changeColor(RED);
-			_rotate(n->parent, _makeSelfie(n));
+			_getSibling(n)->changeColor(n->getParent()->getColor());
+			n->getParent()->changeColor(RED);
+			_rotate(n->getParent(), _makeSelfie(n));
 			_deleteFixUpCase(n);
 		}
 
@@ -468,21 +1480,21 @@ class _Rb_tree {
 		change far child Color to BLACK,
 		_rotate parent of node to node's direction. */
 		void _deleteFixUpCase2(node* n) {
-			_getSibling(n)->changeColor(n->parent->getColor());
-			n->parent->changeColor(BLACK);
+			_getSibling(n)->changeColor(n->getParent()->getColor());
+			n->getParent()->changeColor(BLACK);
 			_getFarChild(n)->changeColor(BLACK);
-			_rotate(n->parent, _makeSelfie(n));
+			_rotate(n->getParent(), _makeSelfie(n));
 		}
 
 		/* sibling of node is BLACK, far child is BLACK, close child is RED,
 		swap close child and sibling of node colors,
 		_rotate sibling of node in opposite direction to node,
-		then call case 4. */
+		then call case 2. */
 		void _deleteFixUpCase3(node* n) {
 			_getCloseChild(n)->changeColor(BLACK);
 			_getSibling(n)->changeColor(RED);
 			_rotate(_getSibling(n), !_makeSelfie(n));
-			_deleteFixUpCase4(n);
+			_deleteFixUpCase2(n);
 		}
 
 		/* sibling of node subtree (sibling, far child, close child) is BLACK,
@@ -491,24 +1503,27 @@ class _Rb_tree {
 		if parent of node was already BLACK check next case in parent of node. */
 		void _deleteFixUpCase4(node* n) {
 			_getSibling(n)->changeColor(RED);
-			if (n->parent->getColor() == BLACK)
-				_deleteFixUpCase(n->parent);
+			if (n->getParent()->getColor() == BLACK)
+				_deleteFixUpCase(n->getParent());
 			else
-				n->parent->changeColor();
+				n->getParent()->changeColor();
 			return;
 		}
 
 
+		node*& _leftmost() const	{ return _lastNode->child[ LEFT ]; }
+		node*& _rightmost() const	{ return _lastNode->child[ RIGHT ]; }
+
 		int _makeSelfie(node* nd) const { 
-			if (nd->parent->child[ LEFT ] == nd)
+			if (nd->getParent()->child[ LEFT ] == nd)
 				return LEFT;
 			return RIGHT;
 		}
 
 		bool _isInnerNode(node* nd) const { return (nd->child[ RIGHT ] && nd->child[ LEFT ]); }
-		node* _getParent(node* nd) const { return nd->parent; }
-		node* _getGrandParent(node* nd) const { return (_getParent(nd->parent)); }
-		node* _getUncle(node* nd) const { return (_getGrandParent(nd)->child[ !_makeSelfie(nd->parent) ]); }
+		node* _getParent(node* nd) const { return nd->getParent(); }
+		node* _getGrandParent(node* nd) const { return (_getParent(nd->getParent())); }
+		node* _getUncle(node* nd) const { return (_getGrandParent(nd)->child[ !_makeSelfie(nd->getParent()) ]); }
 		node* _getSibling(node* nd) const { return (_getParent(nd)->child[ !_makeSelfie(nd) ]); }
 		node* _getCloseChild(node* nd) const { return (_getSibling(nd)->child[ _makeSelfie(nd) ]); }
 		node* _getFarChild(node* nd) const { return (_getSibling(nd)->child[ !_makeSelfie(nd) ]); }
@@ -519,60 +1534,103 @@ class _Rb_tree {
 			return RED;
 		}
 
-		node* _copyTreeFrom(node* n_cpy) {
-			if (!n_cpy)
+		/* copies shape, colors and values of the tree under src without recursion:
+			src is walked in pre-order through its parent links, the copy is built
+			in lockstep and a node is linked as soon as it exists. If a value copy
+			throws, the part already built is destroyed and the pool emptied. */
+		node* _copyTreeFrom(node* src) {
+			if (!src)
 				return NULL;
-			node* _new_n = _tree_alloc.allocate(1);
-			_tree_alloc.construct(_new_n, *n_cpy);
-			_new_n->child[ LEFT ] = _copyTreeFrom(n_cpy->child[ LEFT ]);
-			if (_new_n->child[ LEFT ])
-				_new_n->child[ LEFT ]->parent = _new_n;
-			_new_n->child[ RIGHT ] = _copyTreeFrom(n_cpy->child[ RIGHT ]);
-			if (_new_n->child[ RIGHT ])
-				_new_n->child[ RIGHT ]->parent = _new_n;
-			return _new_n;
+			node*	root = _cloneNode(src, NULL);
+			node*	s = src;
+			node*	d = root;
+			try {
+				while (true) {
+					if (s->child[ LEFT ] && !d->child[ LEFT ]) {
+						d->child[ LEFT ] = _cloneNode(s->child[ LEFT ], d);
+						s = s->child[ LEFT ];
+						d = d->child[ LEFT ];
+					}
+					else if (s->child[ RIGHT ] && !d->child[ RIGHT ]) {
+						d->child[ RIGHT ] = _cloneNode(s->child[ RIGHT ], d);
+						s = s->child[ RIGHT ];
+						d = d->child[ RIGHT ];
+					}
+					else if (s == src)
+						break ;
+					else {
+						s = s->getParent();
+						d = d->getParent();
+					}
+				}
+			}
+			catch (...) {
+				_deleteTreeFrom(root);
+				throw ;
+			}
+			return root;
 		}
 
+		node* _cloneNode(node* src, node* parent) {
+			node* n = _createNode(**src);
+			n->setParent(parent);
+			n->changeColor(src->getColor());
+			n->copyData(*src);
+			return n;
+		}
+
+		/* destroys every node under n_del, then lets go of the pool: a pool this
+			tree holds alone gives its slabs back in one go. In a pool shared with
+			other trees the nodes go back to the free list first, for those to
+			recycle. Only ever called on the root. */
 		void _deleteTreeFrom(node* n_del) {
+			_destroyTreeFrom(n_del, _node_pool.shared());
+			_node_pool.release();
+		}
+
+		void _destroyTreeFrom(node* n_del, bool recycle) {
 			if (!n_del)
 				return ;
-			_deleteTreeFrom(n_del->child[ LEFT ]);
-			_deleteTreeFrom(n_del->child[ RIGHT ]);
-			_tree_alloc.destroy(n_del);
-			_tree_alloc.deallocate(n_del, 1);
+			_destroyTreeFrom(n_del->child[ LEFT ], recycle);
+			_destroyTreeFrom(n_del->child[ RIGHT ], recycle);
+			_node_pool.allocator().destroy(n_del);
+			if (recycle)
+				_node_pool.deallocate(n_del);
 		}
 	};
 
-	template<class T, class Compare, class Alloc>
-	bool operator==(const ft::_Rb_tree< T, Compare, Alloc >& lhs, const ft::_Rb_tree< T, Compare, Alloc >& rhs) {
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Policy>
+	bool operator==(const ft::_Rb_tree< Key, Value, KeyOfValue, Compare, Alloc, Policy >& lhs, const ft::_Rb_tree< Key, Value, KeyOfValue, Compare, Alloc, Policy >& rhs) {
+		if (&lhs == &rhs)
+			return true;
 		if (lhs.size() != rhs.size())
 			return false;
 		return ft::equal(lhs.begin(), lhs.end(), rhs.begin());
 	}
 
-	template<class T, class Compare, class Alloc>
-	bool operator!=(const ft::_Rb_tree< T, Compare, Alloc >& lhs, const ft::_Rb_tree< T, Compare, Alloc >& rhs) {
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Policy>
+	bool operator!=(const ft::_Rb_tree< Key, Value, KeyOfValue, Compare, Alloc, Policy >& lhs, const ft::_Rb_tree< Key, Value, KeyOfValue, Compare, Alloc, Policy >& rhs) {
 		return (!(lhs == rhs));
 	}
 
-	template<class T, class Compare, class Alloc>
-	bool operator<(const ft::_Rb_tree< T, Compare, Alloc >& lhs, const ft::_Rb_tree< T, Compare, Alloc >& rhs) {
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Policy>
+	bool operator<(const ft::_Rb_tree< Key, Value, KeyOfValue, Compare, Alloc, Policy >& lhs, const ft::_Rb_tree< Key, Value, KeyOfValue, Compare, Alloc, Policy >& rhs) {
 		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 	}
 
-	template<class T, class Compare, class Alloc>
-	bool operator<=(const ft::_Rb_tree< T, Compare, Alloc >& lhs, const ft::_Rb_tree< T, Compare, Alloc >& rhs) {
-		return (lhs == rhs || lhs < rhs);
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Policy>
+	bool operator<=(const ft::_Rb_tree< Key, Value, KeyOfValue, Compare, Alloc, Policy >& lhs, const ft::_Rb_tree< Key, Value, KeyOfValue, Compare, Alloc, Policy >& rhs) {
+		return !(rhs < lhs);
 	}
 
-	template<class T, class Compare, class Alloc>
-	bool operator>(const ft::_Rb_tree< T, Compare, Alloc >& lhs, const ft::_Rb_tree< T, Compare, Alloc >& rhs) {
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Policy>
+	bool operator>(const ft::_Rb_tree< Key, Value, KeyOfValue, Compare, Alloc, Policy >& lhs, const ft::_Rb_tree< Key, Value, KeyOfValue, Compare, Alloc, Policy >& rhs) {
 		return (rhs < lhs);
 	}
 
-	template<class T, class Compare, class Alloc>
-	bool operator>=(const ft::_Rb_tree< T, Compare, Alloc >& lhs, const ft::_Rb_tree< T, Compare, Alloc >& rhs) {
-		return (lhs > rhs || lhs == rhs);
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Policy>
+	bool operator>=(const ft::_Rb_tree< Key, Value, KeyOfValue, Compare, Alloc, Policy >& lhs, const ft::_Rb_tree< Key, Value, KeyOfValue, Compare, Alloc, Policy >& rhs) {
+		return !(lhs < rhs);
 	}
 }
 
@@ -61,20 +61,16 @@ class tree_iterator {
 					_current = _current->child[ LEFT ];
 				return *this;
 			}
-			while (_current->parent) {
-				if (*_current < *_current->parent)
-					break;
-				_current = _current->parent;
-			}
-			_current = _current->parent;
+			// climb while coming from a right subtree, the first ancestor reached from the left is next
+			while (_current->getParent() && _current == _current->getParent()->child[ RIGHT ])
+				_current = _current->getParent();
+			_current = _current->getParent();
 			return *this;
 		}
 
 		tree_iterator& operator--() {
-			if (_current == NULL) {
-				_current = _lastNode->parent;
-				while (_current->child[ RIGHT ])
-					_current = _current->child[ RIGHT ];
+			if (_current == NULL) { // end() -> rightmost node, cached in the tree header
+				_current = _lastNode->child[ RIGHT ];
 				return *this;
 			}
 			if (_current->child[ LEFT ]) {
@@ -83,10 +79,10 @@ class tree_iterator {
 					_current = _current->child[ RIGHT ];
 				return *this;
 			}
-			while (*_current < *_current->parent) {
-				_current = _current->parent;
-			}
-			_current = _current->parent;
+			// mirror of operator++, no key is ever compared while walking the tree
+			while (_current->getParent() && _current == _current->getParent()->child[ LEFT ])
+				_current = _current->getParent();
+			_current = _current->getParent();
 			return *this;
 		}
 
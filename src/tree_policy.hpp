@@ -0,0 +1,128 @@
+/*
+ABOUT:
+	tree policies - what ft::map and ft::set keep in a node besides links, color and value
+
+	Every node derives from Policy::node_data<Value>. Whenever the subtree under
+	a node changes shape (a rotation, a node linked below it or unlinked from
+	it, a subtree built or relinked), the tree calls
+	node_data::update(left, right, value) on the node, bottom-up, with the
+	node_data of its two children (NULL for a missing child) and its own value.
+	Policy::augmented tells the tree whether the walks up to the root that keep
+	these data right after an insert or erase are needed at all.
+
+	tree_plain				nothing, the node costs no byte more (the default)
+	tree_order_statistics	the number of nodes in the subtree: nth(), rank() and
+							distance() of the containers run in O(log n)
+	tree_aggregate<M, Base>	the fold of the monoid M over the subtree, in key order,
+							on top of what Base keeps: aggregate(lo, hi) of the
+							containers runs in O(log n)
+
+	Policy::summary_type is what aggregate() returns, void for the policies that fold nothing.
+	A monoid names its summary_type and provides, all static:
+		identity()				the summary of nothing
+		of(value)				the summary of one node value
+		combine(lhs, rhs)		the summary of lhs followed by rhs, associative
+	aggregate_sum, aggregate_min and aggregate_max fold arithmetic values: the
+	elements of a set, the mapped values of a map.
+*/
+
+#ifndef TREE_POLICY_HPP
+#define TREE_POLICY_HPP
+
+#include "pair.hpp"
+#include "utils.hpp"
+
+#include <cstddef>
+#include <limits>
+
+namespace ft {
+
+	struct tree_plain {
+		typedef ft::false_type	augmented;
+		typedef ft::false_type	counted;
+		typedef void			summary_type;
+
+		template<class Value>
+		struct node_data {
+			void update(const node_data*, const node_data*, const Value&) {}
+		};
+	};
+
+	struct tree_order_statistics {
+		typedef ft::true_type	augmented;
+		typedef ft::true_type	counted;
+		typedef void			summary_type;
+
+		template<class Value>
+		struct node_data {
+			size_t	subtree_size;
+
+			node_data() : subtree_size(1) {}
+
+			void update(const node_data* left, const node_data* right, const Value&) {
+				subtree_size = 1 + (left ? left->subtree_size : 0) + (right ? right->subtree_size : 0);
+			}
+		};
+	};
+
+	template<class Monoid, class Base = ft::tree_plain>
+	struct tree_aggregate {
+		typedef ft::true_type					augmented;
+		typedef typename Base::counted			counted;
+		typedef Monoid							monoid_type;
+		typedef typename Monoid::summary_type	summary_type;
+
+		template<class Value>
+		struct node_data : public Base::template node_data<Value> {
+			summary_type	summary;
+
+			node_data() : summary(Monoid::identity()) {}
+
+			void update(const node_data* left, const node_data* right, const Value& value) {
+				Base::template node_data<Value>::update(left, right, value);
+				summary = Monoid::combine(Monoid::combine(left ? left->summary : Monoid::identity(), Monoid::of(value)),
+											right ? right->summary : Monoid::identity());
+			}
+		};
+	};
+
+	/* what the ready-made monoids fold: a set element, the mapped value of a map entry */
+	template<class T>
+	const T& _aggregated(const T& value)									{ return value; }
+
+	template<class Key, class Mapped>
+	const Mapped& _aggregated(const ft::pair<const Key, Mapped>& value)	{ return value.second; }
+
+	template<class T>
+	struct aggregate_sum {
+		typedef T	summary_type;
+
+		static T identity()								{ return T(); }
+		template<class Value>
+		static T of(const Value& value)					{ return T(_aggregated(value)); }
+		static T combine(const T& lhs, const T& rhs)	{ return lhs + rhs; }
+	};
+
+	template<class T>
+	struct aggregate_min {
+		typedef T	summary_type;
+
+		static T identity()								{ return std::numeric_limits<T>::max(); }
+		template<class Value>
+		static T of(const Value& value)					{ return T(_aggregated(value)); }
+		static T combine(const T& lhs, const T& rhs)	{ return (rhs < lhs) ? rhs : lhs; }
+	};
+
+	template<class T>
+	struct aggregate_max {
+		typedef T	summary_type;
+
+		static T identity()								{ return std::numeric_limits<T>::is_integer ? std::numeric_limits<T>::min() : -std::numeric_limits<T>::max(); }
+		template<class Value>
+		static T of(const Value& value)					{ return T(_aggregated(value)); }
+		static T combine(const T& lhs, const T& rhs)	{ return (lhs < rhs) ? rhs : lhs; }
+	};
+
+}
+
+#endif
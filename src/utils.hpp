@@ -7,11 +7,31 @@ ABOUT:
 	is_integral				- https://www.enseignement.polytechnique.fr/informatique/INF478/docs/Cpp/en/cpp/types/integral_constant.html
 	equal					- https://en.cppreference.com/w/cpp/algorithm/equal
 	lexico					- https://en.cppreference.com/w/cpp/algorithm/lexicographical_compare
+
+	move / forward			- https://en.cppreference.com/w/cpp/utility/move
+
+	equal and lexicographical_compare compare two contiguous ranges of the same
+	bitwise comparable type with memcmp, which the C library already runs with
+	SSE2/AVX2 kernels. Every other range goes element by element.
+
+	Built as C++11 (make STD=c++11) ft::move, ft::forward and ft::move_if_noexcept
+	are the std ones and the containers gain move constructors and emplace.
+	In C++98 there are no rvalues, ft::move is a no-op and moving is copying.
 */
 
 #ifndef UTILS_HPP
 #define UTILS_HPP
 
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+#if __cplusplus >= 201103L
+# include <type_traits>
+# include <utility>
+#endif
+
 namespace  ft {
 
 // The type T is enabled as member type enable_if::type if Cond is true
@@ -34,6 +54,9 @@ namespace  ft {
 		operator value_type() const { return value; }
 	};
 
+	typedef integral_constant<bool, true>	true_type;
+	typedef integral_constant<bool, false>	false_type;
+
 	template <class T>
 	struct is_integral : public integral_constant<T, false> {};
 // specifications:
@@ -52,6 +75,14 @@ namespace  ft {
 		template <> struct is_integral<unsigned long long> : public integral_constant<bool, true> {};
 
 
+	template<class T>
+	struct is_floating_point : public integral_constant<bool, false> {};
+// specifications:
+		template <> struct is_floating_point<float> : public integral_constant<bool, true> {};
+		template <> struct is_floating_point<double> : public integral_constant<bool, true> {};
+		template <> struct is_floating_point<long double> : public integral_constant<bool, true> {};
+
+
 	template<class T>
 	struct is_const : public integral_constant<bool, false> {};
 
@@ -68,8 +99,142 @@ namespace  ft {
 	struct is_pointer<T* const> : public integral_constant<bool, true> {};
 
 
-	template<class InputIt1, class InputIt2 >
-	bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2) {
+	template<class T, class U>
+	struct is_same : public integral_constant<bool, false> {};
+
+	template<class T>
+	struct is_same<T, T> : public integral_constant<bool, true> {};
+
+
+	template<bool B, class T, class F>
+	struct conditional { typedef T type; };
+
+	template<class T, class F>
+	struct conditional<false, T, F> { typedef F type; };
+
+
+// Trait class that identifies types whose objects can be copied as raw bytes.
+// Scalars are recognised, a POD struct opts in with a specialization:
+//	template <> struct ft::is_trivially_copyable<my_pod> : public ft::true_type {};
+	template<class T>
+	struct is_trivially_copyable : public integral_constant<bool, is_integral<T>::value
+																|| is_floating_point<T>::value
+																|| is_pointer<T>::value> {};
+
+	template<class T>
+	struct is_trivially_copyable<const T> : public is_trivially_copyable<T> {};
+
+
+// Trait class that identifies allocators whose construct/destroy are a plain
+// placement copy and destructor call, so a container may copy, move and fill
+// trivially copyable elements as raw bytes. Other allocators opt in with a specialization.
+	template<class Alloc>
+	struct is_plain_allocator : public integral_constant<bool, false> {};
+
+	template<class T>
+	struct is_plain_allocator< std::allocator<T> > : public integral_constant<bool, true> {};
+
+
+// The containers move what they own through these, which copy in C++98
+#if __cplusplus >= 201103L
+	using std::move;
+	using std::forward;
+	using std::move_if_noexcept;
+#else
+	template<class T>
+	inline T& move(T& value) { return value; }
+
+	template<class T>
+	inline const T& move_if_noexcept(const T& value) { return value; }
+#endif
+
+// Whether moving a T cannot throw, i.e. whether move_if_noexcept moves it
+#if __cplusplus >= 201103L
+	template<class T>
+	struct is_nothrow_move_constructible : public integral_constant<bool, std::is_nothrow_move_constructible<T>::value> {};
+#else
+	template<class T>
+	struct is_nothrow_move_constructible : public false_type {};
+#endif
+
+
+// Trait class that identifies whether T is a class (or union) type,
+// only class types can be used as an empty base.
+	template<class T>
+	struct _is_class_helper {
+		template<class U> static char test(int U::*);
+		template<class U> static long test(...);
+	};
+
+	template<class T>
+	struct is_class : public integral_constant<bool, sizeof(_is_class_helper<T>::template test<T>(0)) == 1> {};
+
+
+// Trait class that identifies types whose operator== is a comparison of their bytes:
+// integers and pointers, floating point is excluded (0.0 == -0.0, NaN != NaN).
+// A POD struct without padding opts in with a specialization:
+//	template <> struct ft::is_bitwise_comparable<my_pod> : public ft::true_type {};
+	template<class T>
+	struct is_bitwise_comparable : public integral_constant<bool, is_integral<T>::value || is_pointer<T>::value> {};
+
+	template<class T>
+	struct is_bitwise_comparable<const T> : public is_bitwise_comparable<T> {};
+
+
+// Trait class that identifies iterators over contiguous storage,
+// address() gives the pointer behind one. Iterator classes specialize it.
+	template<class Iterator>
+	struct contiguous_iterator_traits : public integral_constant<bool, false> {
+		typedef void	value_type;
+	};
+
+	template<class T>
+	struct contiguous_iterator_traits<T*> : public integral_constant<bool, true> {
+		typedef T		value_type;
+		static const T* address(const T* it) { return it; }
+	};
+
+	template<class T>
+	struct contiguous_iterator_traits<const T*> : public integral_constant<bool, true> {
+		typedef T		value_type;
+		static const T* address(const T* it) { return it; }
+	};
+
+	template<class It1, class It2>
+	struct _bitwise_ranges : public integral_constant<bool, contiguous_iterator_traits<It1>::value
+		&& contiguous_iterator_traits<It2>::value
+		&& is_same<typename contiguous_iterator_traits<It1>::value_type, typename contiguous_iterator_traits<It2>::value_type>::value
+		&& is_bitwise_comparable<typename contiguous_iterator_traits<It1>::value_type>::value> {};
+
+	/* byte offset of the first difference between the n bytes at a and b, n if there is none:
+		memcmp finds the block that differs, only that block is scanned byte by byte */
+	inline size_t _mismatch_bytes(const void* a, const void* b, size_t n) {
+		const unsigned char*	l = static_cast<const unsigned char*>(a);
+		const unsigned char*	r = static_cast<const unsigned char*>(b);
+		const size_t			block = 1024;
+		size_t					off = 0;
+
+		while (off < n) {
+			size_t len = (n - off < block) ? n - off : block;
+			if (std::memcmp(l + off, r + off, len) != 0)
+				break ;
+			off += len;
+		}
+		while (off < n && l[off] == r[off])
+			off++;
+		return off;
+	}
+
+	template<class It1, class It2>
+	bool _equal(It1 first1, It1 last1, It2 first2, true_type) {
+		size_t n = last1 - first1;
+		return n == 0 || std::memcmp(contiguous_iterator_traits<It1>::address(first1),
+			contiguous_iterator_traits<It2>::address(first2),
+			n * sizeof(typename contiguous_iterator_traits<It1>::value_type)) == 0;
+	}
+
+	template<class InputIt1, class InputIt2>
+	bool _equal(InputIt1 first1, InputIt1 last1, InputIt2 first2, false_type) {
 		for (; first1 != last1; ++first1, ++first2) {
 			if (!(*first1 == *first2)) {
 				return false;
@@ -78,6 +243,11 @@ namespace  ft {
 		return true;
 	}
 
+	template<class InputIt1, class InputIt2 >
+	bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2) {
+		return ft::_equal(first1, last1, first2, _bitwise_ranges<InputIt1, InputIt2>());
+	}
+
 // BinaryPredicate indicates whether the elements are considered to match in the context of this function
 	template<class InputIt1, class InputIt2, class BinaryPredicate >
 	bool equal(InputIt1 first1, InputIt1 last1,
@@ -91,18 +261,54 @@ namespace  ft {
 	}
 
 
-//	TRUE if [first1, last1] lexicographically less [first2, last2]
+// memcmp orders bytes as unsigned char, which is the order of these types themselves
+	template<class T>
+	struct _is_memcmp_ordered : public integral_constant<bool, is_same<T, unsigned char>::value
+		|| (is_same<T, char>::value && CHAR_MIN == 0)> {};
+
+	template<class T>
+	bool _lexicographical_bytes(const T* first1, size_t n1, const T* first2, size_t n2, true_type) {
+		int diff = std::memcmp(first1, first2, (n1 < n2) ? n1 : n2);
+		return diff ? diff < 0 : n1 < n2;
+	}
+
+	/* the first element whose bytes differ is the first one that differs, it alone decides */
+	template<class T>
+	bool _lexicographical_bytes(const T* first1, size_t n1, const T* first2, size_t n2, false_type) {
+		size_t n = (n1 < n2) ? n1 : n2;
+		size_t i = _mismatch_bytes(first1, first2, n * sizeof(T)) / sizeof(T);
+		return (i < n) ? first1[i] < first2[i] : n1 < n2;
+	}
+
+	template<class It1, class It2>
+	bool _lexicographical_compare(It1 first1, It1 last1, It2 first2, It2 last2, true_type) {
+		typedef typename contiguous_iterator_traits<It1>::value_type	value_type;
+
+		size_t n1 = last1 - first1;
+		size_t n2 = last2 - first2;
+		if (n1 == 0 || n2 == 0)
+			return n1 < n2;
+		return ft::_lexicographical_bytes(contiguous_iterator_traits<It1>::address(first1), n1,
+			contiguous_iterator_traits<It2>::address(first2), n2, _is_memcmp_ordered<value_type>());
+	}
+
 	template<class InputIt1, class InputIt2>
-	bool lexicographical_compare(InputIt1 first1, InputIt1 last1,
-								InputIt2 first2, InputIt2 last2)
-	{
-		for ( ; (first1 != last1) && (first2 != last2); first1++, first2++ ) {
+	bool _lexicographical_compare(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, false_type) {
+		for ( ; (first1 != last1) && (first2 != last2); ++first1, ++first2 ) {
 			if (*first1 < *first2) return true;
 			if (*first2 < *first1) return false;
 		}
 		return (first1 == last1) && (first2 != last2);
 	}
 
+//	TRUE if [first1, last1] lexicographically less [first2, last2]
+	template<class InputIt1, class InputIt2>
+	bool lexicographical_compare(InputIt1 first1, InputIt1 last1,
+								InputIt2 first2, InputIt2 last2)
+	{
+		return ft::_lexicographical_compare(first1, last1, first2, last2, _bitwise_ranges<InputIt1, InputIt2>());
+	}
+
 	template<class InputIt1, class InputIt2, class Compare>
 	bool lexicographical_compare(InputIt1 first1, InputIt1 last1,
 								InputIt2 first2, InputIt2 last2,
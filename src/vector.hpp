@@ -7,16 +7,21 @@ ABOUT:
 #ifndef VECTOR_HPP
 #define VECTOR_HPP
 
+#include <algorithm>
 #include <cstddef> // for types
+#include <cstring>
 #include <ios>
+#include <memory>
 
+#include "growth_policy.hpp"
 #include "iterator_traits.hpp"
 #include "random_access_iterator.hpp"
+#include "realloc_allocator.hpp"
 #include "reverse_iterator.hpp"
 #include "utils.hpp"
 
 namespace ft {
-	template < class T, class Alloc = std::allocator<T> >
+	template < class T, class Alloc = std::allocator<T>, class Growth = ft::growth_factor_2 >
 	class vector {
 	public:
 		typedef T															value_type;
@@ -31,6 +36,7 @@ namespace ft {
 		typedef ft::reverse_iterator<const_iterator>						const_reverse_iterator;
 		typedef typename ft::iterator_traits<iterator>::difference_type		difference_type; 
 		typedef typename allocator_type::size_type							size_type;
+		typedef Growth														growth_policy;
 
 	private:
 		allocator_type	_alloc;
@@ -38,17 +44,32 @@ namespace ft {
 		pointer			_end;
 		pointer			_edge;
 
-		void Destroy(pointer first, pointer last) {
-			for (; first != last; first++)
-				_alloc.destroy(first);
-		};
+		/* trivially copyable elements under a plain allocator are copied,
+			moved and filled as raw bytes, anything else goes through _alloc */
+		typedef ft::integral_constant<bool, ft::is_trivially_copyable<value_type>::value
+			&& ft::is_plain_allocator<allocator_type>::value>					_trivial;
+
+		/* ... and under an allocator with reallocate() the buffer grows in place */
+		typedef ft::integral_constant<bool, _trivial::value
+			&& ft::is_realloc_allocator<allocator_type>::value>					_reallocates;
+
+		void Destroy(pointer first, pointer last) { _destroy(first, last, _trivial()); }
+
+		/* every element is built through here: in C++11 the arguments are forwarded,
+			so an rvalue is moved into the slot and emplace builds in place */
+#if __cplusplus >= 201103L
+		template <class... Args>
+		void _construct(pointer p, Args&&... args) { std::allocator_traits<allocator_type>::construct(_alloc, p, ft::forward<Args>(args)...); }
+#else
+		void _construct(pointer p, const value_type& value) { _alloc.construct(p, value); }
+#endif
 
 		template <class Iter>
 		pointer Copy(Iter first, Iter last, pointer current) {
 			pointer begin = current;
 			try {
 				for (; first != last; ++current, ++first)
-					_alloc.construct(current, *first);
+					_construct(current, *first);
 			}
 			catch (...) {
 				Destroy(begin, current);
@@ -57,6 +78,317 @@ namespace ft {
 			return current;
 		};
 
+		/* contiguous sources, the only ones memcpy can take */
+		pointer Copy(iterator first, iterator last, pointer current)					{ return _copy(first.base(), last.base(), current, _trivial()); }
+		pointer Copy(const_iterator first, const_iterator last, pointer current)		{ return _copy(first.base(), last.base(), current, _trivial()); }
+		pointer Copy(value_type* first, value_type* last, pointer current)				{ return _copy(first, last, current, _trivial()); }
+		pointer Copy(const value_type* first, const value_type* last, pointer current)	{ return _copy(first, last, current, _trivial()); }
+
+		void _destroy(pointer, pointer, ft::true_type) {}
+
+		void _destroy(pointer first, pointer last, ft::false_type) {
+			for (; first != last; first++)
+				_alloc.destroy(first);
+		}
+
+		pointer _copy(const value_type* first, const value_type* last, pointer current, ft::true_type) {
+			if (first != last)
+				std::memcpy(current, first, (last - first) * sizeof(value_type));
+			return current + (last - first);
+		}
+
+		pointer _copy(const value_type* first, const value_type* last, pointer current, ft::false_type) {
+			return Copy<const value_type*>(first, last, current);
+		}
+
+		/* builds the live range [first, last) over again in the raw slots from current,
+			for a growing buffer or a gap: moved when that cannot throw, so a vector of
+			std::string grows without a single string copy, and copied otherwise,
+			which leaves the source intact if an element throws */
+		pointer Relocate(pointer first, pointer last, pointer current) { return _relocate(first, last, current, _trivial()); }
+
+		pointer _relocate(pointer first, pointer last, pointer current, ft::true_type) {
+			return _copy(first, last, current, ft::true_type());
+		}
+
+		pointer _relocate(pointer first, pointer last, pointer current, ft::false_type) {
+			pointer begin = current;
+			try {
+				for (; first != last; ++current, ++first)
+					_construct(current, ft::move_if_noexcept(*first));
+			}
+			catch (...) {
+				Destroy(begin, current);
+				throw ;
+			}
+			return current;
+		}
+
+		/* constructs count copies of value in the raw slots from dest */
+		void _fill(pointer dest, size_type count, const value_type& value, ft::true_type) {
+			const unsigned char*	bytes = reinterpret_cast<const unsigned char*>(&value);
+			size_type				same = 0;
+
+			while (same < sizeof(value_type) && bytes[same] == bytes[0])
+				same++;
+			if (same == sizeof(value_type))
+				std::memset(dest, bytes[0], count * sizeof(value_type));
+			else
+				for (; count--; dest++)
+					*dest = value;
+		}
+
+		void _fill(pointer dest, size_type count, const value_type& value, ft::false_type) {
+			pointer begin = dest;
+			try {
+				for (; count--; dest++)
+					_construct(dest, value);
+			}
+			catch (...) {
+				Destroy(begin, dest);
+				throw ;
+			}
+		}
+
+		/* capacity to hold extra more elements, as chosen by the growth policy */
+		size_type _recommend(size_type extra, const char* what) const {
+			if (extra > this->max_size() - this->size())
+				throw (std::length_error(what));
+			return Growth::template next<value_type>(this->capacity(), this->size() + extra, this->max_size());
+		}
+
+		/* the one growing path: new_begin holds new_cap slots and the count slots
+			at the offset of pos are already constructed by the caller. Moves the
+			elements around that gap over, then adopts the new storage. */
+		void _adopt(pointer new_begin, size_type new_cap, pointer pos, size_type count) {
+			pointer gap = new_begin + (pos - _begin);
+			try {
+				Relocate(_begin, pos, new_begin);
+			}
+			catch (...) {
+				Destroy(gap, gap + count);
+				_alloc.deallocate(new_begin, new_cap);
+				throw ;
+			}
+			try {
+				Relocate(pos, _end, gap + count);
+			}
+			catch (...) {
+				Destroy(new_begin, gap + count);
+				_alloc.deallocate(new_begin, new_cap);
+				throw ;
+			}
+			size_type new_size = this->size() + count;
+			Destroy(_begin, _end);
+			if (_begin)
+				_alloc.deallocate(_begin, this->capacity());
+			_begin = new_begin;
+			_end = new_begin + new_size;
+			_edge = new_begin + new_cap;
+		}
+
+		void _reserve(size_type new_cap, ft::true_type) {
+			size_type size = this->size();
+			_begin = _alloc.reallocate(_begin, this->capacity(), new_cap);
+			_end = _begin + size;
+			_edge = _begin + new_cap;
+		}
+
+		void _reserve(size_type new_cap, ft::false_type) {
+			_adopt(_alloc.allocate(new_cap), new_cap, _end, 0);
+		}
+
+		/* grows in place to new_cap and opens a raw gap of count slots at pos */
+		pointer _reallocGap(pointer pos, size_type count, size_type new_cap) {
+			size_type offset = pos - _begin;
+			size_type tail = _end - pos;
+			_reserve(new_cap, ft::true_type());
+			pos = _begin + offset;
+			if (tail)
+				std::memmove(pos + count, pos, tail * sizeof(value_type));
+			_end += count;
+			return pos;
+		}
+
+		/* growing paths of the fill and range inserts */
+		void _growFill(pointer pos, size_type count, const value_type& value, size_type new_cap, ft::true_type) {
+			value_type copy(value);
+			_fill(_reallocGap(pos, count, new_cap), count, copy, _trivial());
+		}
+
+		void _growFill(pointer pos, size_type count, const value_type& value, size_type new_cap, ft::false_type) {
+			pointer new_begin = _alloc.allocate(new_cap);
+			try {
+				_fill(new_begin + (pos - _begin), count, value, _trivial());
+			}
+			catch (...) {
+				_alloc.deallocate(new_begin, new_cap);
+				throw ;
+			}
+			_adopt(new_begin, new_cap, pos, count);
+		}
+
+		template <class InputIterator>
+		void _growRange(pointer pos, InputIterator first, InputIterator last, size_type count, size_type new_cap, ft::true_type) {
+			Copy(first, last, _reallocGap(pos, count, new_cap));
+		}
+
+		template <class InputIterator>
+		void _growRange(pointer pos, InputIterator first, InputIterator last, size_type count, size_type new_cap, ft::false_type) {
+			pointer new_begin = _alloc.allocate(new_cap);
+			try {
+				Copy(first, last, new_begin + (pos - _begin));
+			}
+			catch (...) {
+				_alloc.deallocate(new_begin, new_cap);
+				throw ;
+			}
+			_adopt(new_begin, new_cap, pos, count);
+		}
+
+		/* assigns the live range [first, last) onto the live slots from d_first, front to back */
+		pointer _moveForward(pointer first, pointer last, pointer d_first, ft::true_type) {
+			if (first != last)
+				std::memmove(d_first, first, (last - first) * sizeof(value_type));
+			return d_first + (last - first);
+		}
+
+		pointer _moveForward(pointer first, pointer last, pointer d_first, ft::false_type) {
+			for (; first != last; ++first, ++d_first)
+				*d_first = ft::move(*first);
+			return d_first;
+		}
+
+		/* assigns the live range [first, last) onto the live slots ending at d_last, back to front */
+		void _moveBackward(pointer first, pointer last, pointer d_last, ft::true_type) {
+			if (first != last)
+				std::memmove(d_last - (last - first), first, (last - first) * sizeof(value_type));
+		}
+
+		void _moveBackward(pointer first, pointer last, pointer d_last, ft::false_type) {
+			while (first != last)
+				*--d_last = ft::move(*--last);
+		}
+
+		/* range constructor, assign and insert: a forward range is measured first
+			and copied in one go, an input range can only be read once and is
+			appended element by element */
+		template <class ForwardIt>
+		void _initRange(ForwardIt first, ForwardIt last, ft::true_type) {
+			size_type dist = ft::distance(first, last);
+			_begin = _alloc.allocate(dist);
+			_end = _begin;
+			_edge = _begin + dist;
+			try {
+				_end = Copy(first, last, _begin);
+			}
+			catch (...) {
+				_alloc.deallocate(_begin, dist);
+				throw ;
+			}
+		}
+
+		template <class InputIterator>
+		void _initRange(InputIterator first, InputIterator last, ft::false_type) {
+			try {
+				for (; first != last; ++first)
+					this->push_back(*first);
+			}
+			catch (...) {
+				this->clear();
+				_alloc.deallocate(_begin, this->capacity());
+				throw ;
+			}
+		}
+
+		template <class ForwardIt>
+		void _assignRange(ForwardIt first, ForwardIt last, ft::true_type) {
+			this->clear();
+			size_type dist = ft::distance(first, last);
+			if (this->capacity() >= dist)
+				_end = Copy(first, last, _end);
+			else {
+				pointer new_begin = _alloc.allocate(dist);
+				pointer new_end;
+				try {
+					new_end = Copy(first, last, new_begin);
+				}
+				catch (...) {
+					_alloc.deallocate(new_begin, dist);
+					throw ;
+				}
+				_alloc.deallocate(_begin, this->capacity());
+				_begin = new_begin;
+				_end = new_end;
+				_edge = new_begin + dist;
+			}
+		}
+
+		template <class InputIterator>
+		void _assignRange(InputIterator first, InputIterator last, ft::false_type) {
+			this->clear();
+			for (; first != last; ++first)
+				this->push_back(*first);
+		}
+
+		template <class ForwardIt>
+		void _insertRange(pointer pos, ForwardIt first, ForwardIt last, ft::true_type) {
+			size_type dist = ft::distance(first, last);
+			if (dist == 0)
+				return ;
+			if (size_type(_edge - _end) >= dist) {
+				pointer		old_end = _end;
+				size_type	tail = _end - pos;
+				if (tail > dist) {
+					_end = Relocate(_end - dist, _end, _end);
+					_moveBackward(pos, old_end - dist, old_end, _trivial());
+					std::copy(first, last, pos);
+				}
+				else {
+					ForwardIt mid = ft::next(first, tail);
+					_end = Copy(mid, last, _end);
+					_end = Relocate(pos, old_end, _end);
+					std::copy(first, mid, pos);
+				}
+			}
+			else
+				_growRange(pos, first, last, dist, _recommend(dist, "vector::insert (range)"), _reallocates());
+		}
+
+		/* appends, then rotates the new elements into place */
+		template <class InputIterator>
+		void _insertRange(pointer pos, InputIterator first, InputIterator last, ft::false_type) {
+			size_type offset = pos - _begin;
+			size_type old_size = this->size();
+			for (; first != last; ++first)
+				this->push_back(*first);
+			std::rotate(_begin + offset, _begin + old_size, _end);
+		}
+
+#if __cplusplus >= 201103L
+		/* growing path of emplace: the element is built in the new storage before the
+			old elements move over, so args may still refer to them. The tag comes first,
+			a parameter pack has to be last. */
+		template <class... Args>
+		void _growEmplace(ft::true_type, pointer pos, size_type new_cap, Args&&... args) {
+			value_type value(ft::forward<Args>(args)...);
+			_growFill(pos, 1, value, new_cap, ft::true_type());
+		}
+
+		template <class... Args>
+		void _growEmplace(ft::false_type, pointer pos, size_type new_cap, Args&&... args) {
+			pointer new_begin = _alloc.allocate(new_cap);
+			try {
+				_construct(new_begin + (pos - _begin), ft::forward<Args>(args)...);
+			}
+			catch (...) {
+				_alloc.deallocate(new_begin, new_cap);
+				throw ;
+			}
+			_adopt(new_begin, new_cap, pos, 1);
+		}
+#endif
+
 	public:
 // "explicit" -> it cannot be used for implicit conversions and copy-initialization
 		explicit vector(const allocator_type& alloc = allocator_type())
@@ -66,38 +398,74 @@ namespace ft {
 		: _alloc(alloc), _begin(NULL), _end(NULL), _edge(NULL) {
 			_begin = _alloc.allocate(count);
 			_edge = _begin + count;
-			_end = _begin;
-			for(; count--; _end++)
-				_alloc.construct(_end, value);
+			_fill(_begin, count, value, _trivial());
+			_end = _edge;
 		}
 
 		template <class InputIterator>
 		vector(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type(),
-		typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) : _alloc(alloc) {
-			difference_type dist = ft::distance(first, last);
-			_begin = _alloc.allocate(dist);
-			_edge = _begin + dist;
-			_end = _begin;
-			for(; dist--; _end++)
-				_alloc.construct(_end, *first++);
+		typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL)
+		: _alloc(alloc), _begin(NULL), _end(NULL), _edge(NULL) {
+			_initRange(first, last, ft::is_forward_iterator<InputIterator>());
 		}
 
+		/* exactly one allocation of other.size() elements, copied as raw bytes when trivial */
 		vector(const vector& other) : _alloc(other._alloc), _begin(NULL), _end(NULL), _edge(NULL) {
-			this->insert(this->begin(), other.begin(), other.end());
+			if (!other.empty())
+				_initRange(other._begin, other._end, ft::true_type());
 		}
 
+#if __cplusplus >= 201103L
+		/* takes the buffer over, other is left empty */
+		vector(vector&& other) noexcept
+		: _alloc(ft::move(other._alloc)), _begin(other._begin), _end(other._end), _edge(other._edge) {
+			other._begin = NULL;
+			other._end = NULL;
+			other._edge = NULL;
+		}
+#endif
+
 		~vector() {
 			this->clear();
 			_alloc.deallocate(_begin, this->capacity());
 		}
 
+		/* reuses the live elements by assignment, allocates only when other does not fit,
+			and then exactly other.size() elements */
 		vector &operator = (const vector& other) {
-			if (other == *this)
+			if (this == &other)
+				return *this;
+			size_type count = other.size();
+			if (count > this->capacity())
+				_assignRange(other._begin, other._end, ft::true_type());
+			else if (count <= this->size()) {
+				pointer new_end = std::copy(other._begin, other._end, _begin);
+				Destroy(new_end, _end);
+				_end = new_end;
+			}
+			else {
+				std::copy(other._begin, other._begin + this->size(), _begin);
+				_end = Copy(other._begin + this->size(), other._end, _end);
+			}
+			return *this;
+		}
+
+#if __cplusplus >= 201103L
+		vector &operator = (vector&& other) noexcept {
+			if (this == &other)
 				return *this;
 			this->clear();
-			this->insert(this->end(), other.begin(), other.end());
+			_alloc.deallocate(_begin, this->capacity());
+			_alloc = ft::move(other._alloc);
+			_begin = other._begin;
+			_end = other._end;
+			_edge = other._edge;
+			other._begin = NULL;
+			other._end = NULL;
+			other._edge = NULL;
 			return *this;
 		}
+#endif
 
 		void resize(size_type count, value_type value = value_type()) {
 			if (count > this->max_size())
@@ -113,24 +481,7 @@ namespace ft {
 			if (this->max_size() < new_cap)
 				throw (std::length_error("vector::reserve"));
 			else if (this->capacity() < new_cap)
-			{
-				pointer copy = _alloc.allocate(new_cap);
-				try {
-					Copy(this->begin(), this->end(), copy);
-				}
-				catch (...) {
-					_alloc.deallocate(copy, new_cap);
-					throw ;
-				}
-				if (_begin != 0)
-				{
-					Destroy(_begin, _end);
-					_alloc.deallocate(_begin, _edge - _begin);
-				}
-				_edge = copy + new_cap;
-				_end = copy + this->size();
-				_begin = copy;
-			}
+				_reserve(new_cap, _reallocates());
 		}
 
 		iterator begin()								{ return _begin; };
@@ -145,6 +496,7 @@ namespace ft {
 		size_type capacity (void) const 				{ return (this->_edge - this->_begin); }
 		bool empty (void) const 						{ return (size() == 0 ? true : false); }
 		size_type max_size(void) const 					{ return allocator_type().max_size(); }
+		allocator_type get_allocator() const			{ return _alloc; }
 		reference operator[] (size_type n)				{ return *(_begin + n); }
 		const_reference operator[] (size_type n) const	{ return *(_begin + n); }
 		reference front () 								{ return *_begin; }
@@ -166,13 +518,27 @@ namespace ft {
 
 		void push_back(const value_type& value) {
 			if (_end == _edge) {
-				int new_capacity = (this->size() > 0) ? (int)(this->size() * 2) : 1;
-				this->reserve(new_capacity);
+				this->insert(this->end(), value);
+				return ;
 			}
-			_alloc.construct(_end, value);
+			_construct(_end, value);
 			_end++;
 		}
 
+#if __cplusplus >= 201103L
+		void push_back(value_type&& value) { this->emplace_back(ft::move(value)); }
+
+		template <class... Args>
+		void emplace_back(Args&&... args) {
+			if (_end == _edge) {
+				this->emplace(this->end(), ft::forward<Args>(args)...);
+				return ;
+			}
+			_construct(_end, ft::forward<Args>(args)...);
+			_end++;
+		}
+#endif
+
 		void pop_back() {
 			_alloc.destroy(&this->back());
 			_end--;
@@ -182,192 +548,111 @@ namespace ft {
 			this->clear();
 			if (count == 0)
 				return ;
-			if (this->capacity() >= count) {
-				for(; count--; _end++)
-					_alloc.construct(_end , value);
-			}
-			else {
+			if (this->capacity() < count) {
 				_alloc.deallocate(_begin, this->capacity());
 				_begin = _alloc.allocate(count);
 				_end = _begin;
 				_edge = _begin + count;
-				for(; count--; _end++)
-					_alloc.construct(_end , value);
 			}
+			_fill(_end, count, value, _trivial());
+			_end += count;
 		}
 
 		template <class InputIterator>
 		void assign(InputIterator first, InputIterator last,
 		typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) {
-			this->clear();
-			size_type dist = ft::distance(first, last);
-			if (this->capacity() >= dist) {
-				for(; &(*first) != &(*last); first++, _end++)
-					_alloc.construct(_end, *first);
+			_assignRange(first, last, ft::is_forward_iterator<InputIterator>());
+		}
+
+		iterator insert(iterator pos, const value_type& value) {
+			size_type length_to_pos = pos.base() - _begin;
+			if (_end == pos.base() && _end != _edge) {
+				_construct(_end, value);
+				_end++;
 			}
-			else {
-				pointer new_begin = pointer();
-				pointer new_end = pointer();
-				pointer new_edge = pointer();
-				new_begin = _alloc.allocate(dist);
-				new_end = new_begin;
-				new_edge = new_begin + dist;
-				for(; &(*first) != &(*last); first++, new_end++)
-					_alloc.construct(new_end, *first);
-				_alloc.deallocate(_begin, this->capacity());
-				_begin = new_begin;
-				_end = new_end;
-				_edge = new_edge;
+			else if (_end != _edge) {
+				value_type copy(value); // value may live in the part that is about to move
+				_construct(_end, ft::move(*(_end - 1)));
+				_end++;
+				_moveBackward(pos.base(), _end - 2, _end - 1, _trivial());
+				*pos = ft::move(copy);
 			}
+			else
+				_growFill(pos.base(), 1, value, _recommend(1, "vector::insert"), _reallocates());
+			return iterator(_begin + length_to_pos);
 		}
 
-		iterator insert(iterator pos, const value_type& value) {
-			size_type length_to_pos = &(*pos) - _begin;
-			if (size_type(_edge - _end) >= this->size() + 1) {
-				for (size_type i = 0; i < length_to_pos; i++)
-					_alloc.construct(_end - i, *(_end - i - 1));
+#if __cplusplus >= 201103L
+		iterator insert(iterator pos, value_type&& value) { return this->emplace(pos, ft::move(value)); }
+
+		/* builds the element in place at the end or in new storage, in the middle
+			it is built aside first: args may refer to the elements about to move */
+		template <class... Args>
+		iterator emplace(const_iterator pos, Args&&... args) {
+			size_type offset = pos.base() - _begin;
+			if (_end == _edge)
+				_growEmplace(_reallocates(), _begin + offset, _recommend(1, "vector::emplace"), ft::forward<Args>(args)...);
+			else if (_begin + offset == _end) {
+				_construct(_end, ft::forward<Args>(args)...);
 				_end++;
-				_alloc.construct(&(*pos), value);
 			}
 			else {
-				pointer new_begin = pointer();
-				pointer new_end = pointer();
-				pointer new_edge = pointer();
-				int new_capacity = (this->size() * 2 > 0) ? this->size() * 2 : 1; 
-				new_begin = _alloc.allocate(new_capacity);
-				new_end = new_begin + this->size() + 1;
-				new_edge = new_begin + new_capacity;
-				for (size_type i = 0; i < length_to_pos; i++)
-					_alloc.construct(new_begin + i, *(_begin + i));
-				_alloc.construct(new_begin + length_to_pos, value);
-				for (size_type j = 0; j < this->size() - length_to_pos; j++)
-					_alloc.construct(new_end - j - 1, *(_end - j - 1));
-				for (size_type x = 0; x < this->size(); x++)
-					_alloc.destroy(_begin + x);
-				if (_begin)
-					_alloc.deallocate(_begin, this->capacity());
-				_begin = new_begin;
-				_end = new_end;
-				_edge = new_edge;
+				value_type value(ft::forward<Args>(args)...);
+				_construct(_end, ft::move(*(_end - 1)));
+				_end++;
+				_moveBackward(_begin + offset, _end - 2, _end - 1, _trivial());
+				_begin[offset] = ft::move(value);
 			}
-			return iterator(_begin + length_to_pos);
+			return iterator(_begin + offset);
 		}
+#endif
 
 		void insert(iterator pos, size_type count, const value_type& value) {
 			if (count == 0)
 				return ;
-			if (count > this->max_size())
-				throw (std::length_error("vector::insert (fill)"));
-			size_type length_to_pos = &(*pos) - _begin;
 			if (size_type(_edge - _end) >= count) {
-				for (size_type i = 0; i < this->size() - length_to_pos; i++)
-					_alloc.construct(_end - i + (count - 1), *(_end - i - 1));
-				_end += count;
-				for(; count; count--)
-					_alloc.construct(&(*pos) + (count - 1), value);
-			}
-			else {
-				pointer new_begin = pointer();
-				pointer new_end = pointer();
-				pointer new_edge = pointer();
-				int new_capacity = (this->capacity() > 0) ? (int)(this->size() * 2) : 1;
-				new_begin = _alloc.allocate(new_capacity);
-				new_edge = new_begin + new_capacity;
-				if (size_type(new_edge - new_begin) < this->size() + count) {
-					if (new_begin)
-						_alloc.deallocate(new_begin, new_begin - new_edge);
-					new_capacity = this->size() + count;
-					new_begin = _alloc.allocate(new_capacity);
-					new_end = new_begin + this->size() + count;
-					new_edge = new_begin + new_capacity;
+				value_type	copy(value);
+				pointer		old_end = _end;
+				size_type	tail = _end - pos.base();
+				if (tail > count) {
+					_end = Relocate(_end - count, _end, _end);
+					_moveBackward(pos.base(), old_end - count, old_end, _trivial());
+					std::fill(pos.base(), pos.base() + count, copy);
+				}
+				else {
+					_fill(_end, count - tail, copy, _trivial());
+					_end += count - tail;
+					_end = Relocate(pos.base(), old_end, _end);
+					std::fill(pos.base(), old_end, copy);
 				}
-				new_end = new_begin + this->size() + count;
-				for (int i = 0; i < (&(*pos) - _begin); i++)
-					_alloc.construct(new_begin + i, *(_begin + i));
-				for (size_type n = 0; n < count; n++)
-					_alloc.construct(new_begin + length_to_pos + n, value);
-				for (size_type j = 0; j < (this->size() - length_to_pos); j++)
-					_alloc.construct(new_end - j - 1, *(_end - j - 1));
-				for (size_type x = 0; x < this->size(); x++)
-					_alloc.destroy(_begin + x);
-				if (_begin)
-					_alloc.deallocate(_begin, this->capacity());
-				_begin = new_begin;
-				_end = new_end;
-				_edge = new_edge;
 			}
+			else
+				_growFill(pos.base(), count, value, _recommend(count, "vector::insert (fill)"), _reallocates());
 		}
 
 		template <class InputIterator>
 		void insert(iterator pos, InputIterator first, InputIterator last,
 		typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = NULL) {
-			size_type dist = ft::distance(first, last);
-			if (size_type(_edge - _end) >= dist) {
-				for(size_type i = 0; i < this->size() - (&(*pos) - _begin); i++)
-					_alloc.construct(_end - i + (dist - 1), *(_end - i - 1));
-				_end += dist;
-				for (; &(*first) != &(*last); first++, pos++)
-					_alloc.construct(&(*pos), *first);
-			}
-			else {
-				pointer new_begin = pointer();
-				pointer new_end = pointer();
-				pointer new_edge = pointer();
-				new_begin = _alloc.allocate(this->size() * 2);
-				new_edge = new_begin + (this->size() * 2);
-				new_end = new_begin + this->size() + dist;
-				if (size_type(new_edge - new_begin) < this->size() + dist) {
-					if (new_begin)
-						_alloc.deallocate(new_begin, new_edge - new_begin);
-					new_begin = _alloc.allocate(this->size() + dist);
-					new_end = new_begin + this->size() + dist;
-					new_edge = new_end;
-				}
-				for (int i = 0; i < &(*pos) - _begin; i++)
-					_alloc.construct(new_begin + i, *(_begin + i));
-				for (int j = 0; &(*first) != &(*last); first++, j++)
-					_alloc.construct(new_begin + (&(*pos) - _begin) + j, *first);
-				for (size_type n = 0; n < this->size() - (&(*pos) - _begin); n++)
-					_alloc.construct(new_begin + (&(*pos) - _begin) + dist + n, *(_begin + (&(*pos) - _begin) + n));
-				for (size_type x = 0; x < this->size(); x++)
-					_alloc.destroy(_begin + x);
-				_alloc.deallocate(_begin, this->capacity());
-				_begin = new_begin;
-				_end = new_end;
-				_edge = new_edge;
-			}
+			_insertRange(pos.base(), first, last, ft::is_forward_iterator<InputIterator>());
 		}
 
 		iterator erase(iterator pos) {
-			pointer ret_pos = &(*pos);
-			if (&(*pos) + 1 == _end)
-				_alloc.destroy(&(*pos));
-			else {
-				_alloc.destroy(&(*pos));
-				for (int i = 0; i < _end - &(*pos) - 1; i++) {
-					_alloc.construct(&(*pos) + i, *(&(*pos) + i + 1));
-					_alloc.destroy(&(*pos) + i + 1);
-				}
-			}
-			_end -= 1;
-			return iterator(ret_pos);
+			_moveForward(pos.base() + 1, _end, pos.base(), _trivial());
+			_end--;
+			_alloc.destroy(_end);
+			return pos;
 		}
 
 		iterator erase(iterator first, iterator last) {
-			pointer ret_pos = &(*first);
-			for (; &(*first) != &(*last); first++)
-				_alloc.destroy(&(*first));
-			for (int i = 0; i < _end - &(*last); i++) {
-				_alloc.construct(ret_pos + i, *(&(*last) + i));
-				_alloc.destroy(&(*last) + i);
-			}
-			_end -= (&(*last) - ret_pos);
-			return iterator(ret_pos);
+			if (first == last)
+				return first;
+			pointer new_end = _moveForward(last.base(), _end, first.base(), _trivial());
+			Destroy(new_end, _end);
+			_end = new_end;
+			return first;
 		}
 
 		void swap(vector& other) {
-			if (other == *this)
-				return;
 			pointer tmp_begin = other._begin;
 			pointer tmp_end = other._end;
 			pointer tmp_edge = other._edge;
@@ -383,49 +668,44 @@ namespace ft {
 		}
 
 		void clear() {
-			size_type tmp_size = this->size();
-			for (size_type i = 0; i < tmp_size; i++) {
-				_end--;
-				_alloc.destroy(_end);
-			}
+			Destroy(_begin, _end);
+			_end = _begin;
 		}
 	};
 
-	template <class T, class Alloc>
+	template <class T, class Alloc, class Growth>
 	inline
-	bool operator == (const ft::vector<T, Alloc>& lhs, const ft::vector<T, Alloc>& rhs) {
+	bool operator == (const ft::vector<T, Alloc, Growth>& lhs, const ft::vector<T, Alloc, Growth>& rhs) {
+		if (&lhs == &rhs)
+			return true;
 		if (lhs.size() != rhs.size())
 			return false;
-		for (size_t i = 0; i < lhs.size(); ++i) {
-			if (lhs[i] == rhs[i]) { continue; }
-			return false;
-		}
-		return true;
+		return ft::equal(lhs.begin(), lhs.end(), rhs.begin());
 	}
 
-	template <class T, class Alloc>
+	template <class T, class Alloc, class Growth>
 	inline
-	bool operator != (const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) { return !(lhs == rhs); }
+	bool operator != (const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) { return !(lhs == rhs); }
 	
-	template <class T, class Alloc>
+	template <class T, class Alloc, class Growth>
 	inline
-	bool operator < (const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) { return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+	bool operator < (const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) { return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
 
-	template <class T, class Alloc>
+	template <class T, class Alloc, class Growth>
 	inline
-	bool operator <= (const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) { return !(rhs < lhs); }
+	bool operator <= (const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) { return !(rhs < lhs); }
 
-	template <class T, class Alloc>
+	template <class T, class Alloc, class Growth>
 	inline
-	bool operator > (const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) { return rhs < lhs; }
+	bool operator > (const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) { return rhs < lhs; }
 
-	template <class T, class Alloc>
+	template <class T, class Alloc, class Growth>
 	inline
-	bool operator >= (const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) { return !(lhs < rhs); }
+	bool operator >= (const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) { return !(lhs < rhs); }
 
 
-	template <class T, class Alloc>
-	void swap (vector<T,Alloc>& one, vector<T,Alloc>&other) { one.swap(other); }
+	template <class T, class Alloc, class Growth>
+	void swap (vector<T, Alloc, Growth>& one, vector<T, Alloc, Growth>& other) { one.swap(other); }
 }
 
 #endif